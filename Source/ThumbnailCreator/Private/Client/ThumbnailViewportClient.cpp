@@ -4,9 +4,12 @@
 //Thumbnail Core
 #include "Objects/ThumbnailOptions.h"
 #include "ThumbnailCreator.h"
+#include "Pipeline/ThumbnailPipeline.h"
+#include "Pipeline/ThumbnailViewportCaptureBackend.h"
 
 //Image
 #include "Runtime/Engine/Public/HighResScreenshot.h"
+#include "UnrealClient.h"
 
 //Engine
 #include "AssetEditorModeManager.h"
@@ -18,6 +21,7 @@
 //Components
 #include "Components/SkeletalMeshComponent.h"
 #include "Runtime/Engine/Classes/Components/PostProcessComponent.h"
+#include "Animation/AnimSingleNodeInstance.h"
 #include "Runtime/Engine/Classes/Materials/MaterialInterface.h"
 
 //Scene
@@ -28,6 +32,11 @@
 #include "Runtime/Engine/Public/PreviewScene.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("Component Swap"), STAT_ThumbnailComponentSwap, STATGROUP_ThumbnailCreator);
+
+//Orbiting is a stream of small inputs, stay realtime in between them
+static const double InputRealtimeSeconds = 0.5;
+
 FThumbnailViewportClient::FThumbnailViewportClient(const TSharedRef<SThumbnailViewport>& InThumbnailViewport, const TSharedRef<FAdvancedPreviewScene>& InPreviewScene) 
 : FEditorViewportClient(nullptr, &InPreviewScene.Get(), StaticCastSharedRef<SEditorViewport>(InThumbnailViewport))
 , ViewportPtr(InThumbnailViewport)
@@ -35,7 +44,7 @@ FThumbnailViewportClient::FThumbnailViewportClient(const TSharedRef<SThumbnailVi
 
 	AdvancedPreviewScene = static_cast<FAdvancedPreviewScene*>(PreviewScene);
 
-	// Enable RealTime
+	// Start realtime, Tick drops to on demand redraws once nothing moves
 	SetRealtime(true);
 
 	// Hide grid, we don't need this.
@@ -94,8 +103,8 @@ FThumbnailViewportClient::FThumbnailViewportClient(const TSharedRef<SThumbnailVi
 	EngineShowFlags.SetPostProcessMaterial(true);
 	EngineShowFlags.SetPostProcessing(true);
 
-	//Force screen percentage higher
-	PostComp->Settings.ScreenPercentage_DEPRECATED = 200;
+	//Shots are supersampled by rendering them larger and filtering them down on a worker
+	PostComp->Settings.ScreenPercentage_DEPRECATED = 100;
 
 	//Unbound
 	PostComp->bUnbound = true;
@@ -114,26 +123,175 @@ FThumbnailViewportClient::FThumbnailViewportClient(const TSharedRef<SThumbnailVi
 
 void FThumbnailViewportClient::Tick(float DeltaSeconds)
 {
+	UpdateRealtime();
+
 	FEditorViewportClient::Tick(DeltaSeconds);
 
-	// Tick the preview scene world.
-	if (!GIntraFrameDebuggingGameThread)
+	// Tick the preview scene world, an idle scene has nothing to advance
+	if (!GIntraFrameDebuggingGameThread && bRealtimeRequested)
 	{
 		if(AdvancedPreviewScene)
 		AdvancedPreviewScene->GetWorld()->Tick(LEVELTICK_All, DeltaSeconds);
 	}
 }
 
+bool FThumbnailViewportClient::InputKey(const FInputKeyEventArgs& EventArgs)
+{
+	LastInputTime = FPlatformTime::Seconds();
+	UpdateRealtime();
+	return FEditorViewportClient::InputKey(EventArgs);
+}
+
+bool FThumbnailViewportClient::InputAxis(FViewport* InViewport, FInputDeviceId DeviceID, FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad)
+{
+	LastInputTime = FPlatformTime::Seconds();
+	UpdateRealtime();
+	return FEditorViewportClient::InputAxis(InViewport, DeviceID, Key, Delta, DeltaTime, NumSamples, bGamepad);
+}
+
+void FThumbnailViewportClient::ApplyCaptureProfile()
+{
+	if (!ThumbnailOptions)
+	{
+		return;
+	}
+
+	if (!PreviewShowFlags.IsSet())
+	{
+		PreviewShowFlags = EngineShowFlags;
+	}
+
+	const FThumbnailCaptureProfile& Profile = ThumbnailOptions->GetCaptureProfile();
+	Profile.ApplyToShowFlags(EngineShowFlags);
+
+	//The material preview sphere keeps its own LOD
+	if (ActiveType != EScreenshotType::Material)
+	{
+		Profile.ApplyToComponent(GetActiveComponent());
+	}
+}
+
+void FThumbnailViewportClient::RestoreCaptureProfile()
+{
+	if (!PreviewShowFlags.IsSet())
+	{
+		return;
+	}
+
+	EngineShowFlags = PreviewShowFlags.GetValue();
+	PreviewShowFlags.Reset();
+
+	//0 is the automatic LOD
+	FThumbnailCaptureProfile AutomaticLod;
+	AutomaticLod.ForcedLod = 0;
+	AutomaticLod.ApplyToComponent(MeshComp);
+	AutomaticLod.ApplyToComponent(SkelMeshComp);
+	Invalidate();
+}
+
+bool FThumbnailViewportClient::WantsRealtime() const
+{
+	if (!ThumbnailOptions || ThumbnailOptions->bAlwaysRealtime)
+	{
+		return true;
+	}
+
+	//User is orbiting or zooming
+	if (FPlatformTime::Seconds() - LastInputTime < InputRealtimeSeconds)
+	{
+		return true;
+	}
+
+	//Animation preview keeps moving
+	if (ActiveType == EScreenshotType::Skeletal && SkelMeshComp->IsVisible())
+	{
+		const UAnimSingleNodeInstance* AnimInstance = SkelMeshComp->GetSingleNodeInstance();
+		if (AnimInstance && AnimInstance->IsPlaying())
+		{
+			return true;
+		}
+	}
+
+	//Shot requested, or an asset streaming in for one
+	return !PendingCaptureName.IsEmpty() || bPipelineBusy;
+}
+
+void FThumbnailViewportClient::SetPipelineBusy(bool bBusy)
+{
+	bPipelineBusy = bBusy;
+	UpdateRealtime();
+}
+
+void FThumbnailViewportClient::UpdateRealtime()
+{
+	const bool bRealtime = WantsRealtime();
+	if (bRealtime == bRealtimeRequested)
+	{
+		return;
+	}
+
+	bRealtimeRequested = bRealtime;
+	SetRealtime(bRealtime);
+
+	//Draw the final state once, later redraws only happen when something invalidates the viewport
+	Invalidate();
+}
+
+bool FThumbnailViewportClient::ProcessScreenShots(FViewport* InViewport)
+{
+	auto ModulePtr = FModuleManager::GetModulePtr<FThumbnailCreatorModule>(FName("ThumbnailCreator"));
+
+	//Pipeline capture, read the pixels ourselves, the png copy is written by a worker if wanted
+	if (GIsHighResScreenshot && !PendingCaptureName.IsEmpty())
+	{
+		FThumbnailImage Image;
+		Image.AssetName = MoveTemp(PendingCaptureName);
+		Image.Size = InViewport->GetSizeXY();
+		Image.Supersample = PendingSupersample;
+		PendingCaptureName.Reset();
+
+		const FIntRect CaptureRect(FIntPoint::ZeroValue, Image.Size);
+		if (GetViewportScreenShot(InViewport, Image.Pixels, CaptureRect))
+		{
+			//Stencil mask into the alpha channel, same as the written screenshots
+			GetHighResScreenshotConfig().MergeMaskIntoAlpha(Image.Pixels, CaptureRect);
+		}
+		else
+		{
+			Image.Pixels.Empty();
+		}
+		//Same bookkeeping as FEditorViewportClient::ProcessScreenShots once a request is done
+		FScreenshotRequest::Reset();
+		FScreenshotRequest::OnScreenshotRequestProcessed().Broadcast();
+		GAreScreenMessagesEnabled = GScreenMessagesRestoreState;
+		InViewport->InvalidateHitProxy();
+		RestoreCaptureProfile();
+
+		if (ModulePtr && ModulePtr->Pipeline.IsValid())
+		{
+			ModulePtr->Pipeline->GetViewportBackend().OnViewportReadback(MoveTemp(Image));
+		}
+		return false;
+	}
+
+	//Someone else took a high-res shot of this viewport, the pipeline picks up the written file from the directory watcher
+	return FEditorViewportClient::ProcessScreenShots(InViewport);
+}
+
 void FThumbnailViewportClient::TakeSingleShot()
 {
-	//set the size of the screenshot
-	GScreenshotResolutionX = ThumbnailOptions->ScreenshotXSize;
-	GScreenshotResolutionY = ThumbnailOptions->ScreenshotYSize;
+	//set the size of the screenshot, larger by the supersample factor of the profile
+	ApplyCaptureProfile();
+	PendingSupersample = FMath::Max(1, ThumbnailOptions->GetCaptureProfile().Supersample);
+	GScreenshotResolutionX = ThumbnailOptions->ScreenshotXSize * PendingSupersample;
+	GScreenshotResolutionY = ThumbnailOptions->ScreenshotYSize * PendingSupersample;
 
 	//Set the name of the screenshot
 	FString UseName = GetAssetName();
 
-	GetHighResScreenshotConfig().FilenameOverride = FPaths::ProjectSavedDir() + "Thumbnails/Thumb_" + UseName;
+	//Read back in ProcessScreenShots under this name
+	PendingCaptureName = "Thumb_" + UseName;
+	UpdateRealtime();
 
 	if (ThumbnailOptions->bUseAutoSize)
 	{
@@ -141,13 +299,20 @@ void FThumbnailViewportClient::TakeSingleShot()
 	}
 	//Take the shots
 	TakeHighResScreenShot();
+}
 
-	//Remove this image from known images so we can process it again
-	auto ModulePtr = FModuleManager::LoadModulePtr<FThumbnailCreatorModule>(FName("ThumbnailCreator"));
-	if (ModulePtr)
+void FThumbnailViewportClient::CancelPendingShot()
+{
+	if (PendingCaptureName.IsEmpty())
 	{
-		ModulePtr->RemoveFromPreKnown(UseName);
+		return;
 	}
+
+	PendingCaptureName.Reset();
+	GIsHighResScreenshot = false;
+	FScreenshotRequest::Reset();
+	RestoreCaptureProfile();
+	UpdateRealtime();
 }
 
 void FThumbnailViewportClient::UpdateViewportTransform(const int32 FOV, const double Pitch, const double Yaw, const float Zoom)
@@ -167,6 +332,7 @@ void FThumbnailViewportClient::UpdateViewportTransform(const int32 FOV, const do
 	ViewFOV = FOV;
 	SetViewRotation(FRotator(Pitch, Yaw, 0));
 	SetViewLocationForOrbiting(orbitPoint, radius*4+Zoom);
+	Invalidate();
 }
 
 void FThumbnailViewportClient::ResetScene()
@@ -238,6 +404,8 @@ void FThumbnailViewportClient::SetMaterial(UMaterialInterface* inMaterial, bool
 
 void FThumbnailViewportClient::SetComponentVisibility(UActorComponent* ComponentToActivate, EScreenshotType Type)
 {
+	THUMBNAIL_SCOPE(STAT_ThumbnailComponentSwap);
+
 	//go over all components and only show the one we want to activate
 	for (UPrimitiveComponent* Comp : ActorComponents)
 	{
@@ -246,6 +414,10 @@ void FThumbnailViewportClient::SetComponentVisibility(UActorComponent* Component
 
 	//Set the active type afterwards
 	ActiveType = Type;
+
+	//Not realtime while idle, show the new asset
+	Invalidate();
+	UpdateRealtime();
 }
 
 
@@ -271,3 +443,15 @@ FString FThumbnailViewportClient::GetAssetName()
 	}
 }
 
+UPrimitiveComponent* FThumbnailViewportClient::GetActiveComponent() const
+{
+	if (ActiveType == EScreenshotType::Mesh)
+	{
+		return MeshComp;
+	}
+	else if (ActiveType == EScreenshotType::Skeletal)
+	{
+		return SkelMeshComp;
+	}
+	return MaterialComp;
+}
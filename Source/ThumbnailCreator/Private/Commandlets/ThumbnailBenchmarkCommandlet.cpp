@@ -0,0 +1,206 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Commandlets/ThumbnailBenchmarkCommandlet.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Objects/ThumbnailOptions.h"
+#include "Pipeline/ThumbnailPipeline.h"
+#include "Pipeline/ThumbnailImporter.h"
+
+//Engine
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/FileHelper.h"
+#include "UObject/Package.h"
+
+//Json
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+//Latency of a stage at a percentile in milliseconds
+static double GetPercentileMs(TArray<double>& Seconds, double Percentile)
+{
+	if (Seconds.Num() == 0)
+	{
+		return 0.0;
+	}
+	Seconds.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Seconds.Num()) - 1, 0, Seconds.Num() - 1);
+	return Seconds[Index] * 1000.0;
+}
+
+int32 UThumbnailBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const int32 Count = ParamsMap.Contains(TEXT("Count")) ? FMath::Max(1, FCString::Atoi(*ParamsMap[TEXT("Count")])) : 32;
+	const FString OutputFile = ParamsMap.Contains(TEXT("Output")) ? ParamsMap[TEXT("Output")] : FPaths::ProjectSavedDir() + TEXT("ThumbnailCreator/Benchmark.json");
+
+	TArray<FString> SizeNames;
+	(ParamsMap.Contains(TEXT("Sizes")) ? ParamsMap[TEXT("Sizes")] : FString(TEXT("256+512+2048"))).ParseIntoArray(SizeNames, TEXT("+"));
+
+	FThumbnailCreatorModule& Module = FModuleManager::LoadModuleChecked<FThumbnailCreatorModule>(TEXT("ThumbnailCreator"));
+	if (!Module.ThumbnailOptions)
+	{
+		Module.ThumbnailOptions = NewObject<UThumbnailOptions>(GetTransientPackage(), UThumbnailOptions::StaticClass());
+		Module.ThumbnailOptions->AddToRoot();
+	}
+
+	//Same work on every run, nothing is skipped and nothing ends up in the project
+	UThumbnailOptions* Options = Module.ThumbnailOptions;
+	Options->CaptureBackend = EThumbnailCaptureBackend::Synthetic;
+	Options->bSkipUnchanged = false;
+	Options->bCaptureToMemory = true;
+	Options->SaveGroupSize = 0;
+	ApplyOptionOverrides(Options, ParamsMap);
+
+	FThumbnailPipeline& Pipeline = Module.GetPipeline();
+
+	TArray<TSharedPtr<FJsonValue>> Runs;
+	bool bAnyFailed = false;
+	for (const FString& SizeName : SizeNames)
+	{
+		const int32 Size = FCString::Atoi(*SizeName);
+		if (Size <= 0)
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("Skipping invalid size %s"), *SizeName);
+			continue;
+		}
+		Options->ScreenshotXSize = Size;
+		Options->ScreenshotYSize = Size;
+
+		TArray<UObject*> Objects;
+		const TArray<FAssetData> Assets = CreateBenchmarkAssets(Count, Size, Objects);
+
+		//Stage latencies of every imported thumbnail
+		TArray<double> Load, Ready, Capture, Process, Import, Total;
+		TArray<FString> Thumbnails;
+		const FDelegateHandle ImportedHandle = Pipeline.OnImported.AddLambda([&](const FThumbnailImage& Image)
+		{
+			Thumbnails.Add(Image.AssetName);
+			Load.Add(Image.Timings.Load);
+			Ready.Add(Image.Timings.Ready);
+			Capture.Add(Image.Timings.Capture);
+			Process.Add(Image.Timings.Process);
+			Import.Add(Image.Timings.Import);
+			Total.Add(FPlatformTime::Seconds() - Image.Timings.Begin);
+		});
+
+		Pipeline.ResetStats();
+		const double StartTime = FPlatformTime::Seconds();
+		Pipeline.EnqueueAssets(Assets);
+		RunUntilIdle(Pipeline);
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		Pipeline.OnImported.Remove(ImportedHandle);
+
+		const FThumbnailPipelineStats& Stats = Pipeline.GetStats();
+		bAnyFailed |= Stats.Failed > 0;
+
+		TSharedRef<FJsonObject> Run = MakeShared<FJsonObject>();
+		Run->SetNumberField(TEXT("Size"), Size);
+		Run->SetNumberField(TEXT("Assets"), Assets.Num());
+		Run->SetNumberField(TEXT("Imported"), Stats.Imported);
+		Run->SetNumberField(TEXT("Failed"), Stats.Failed);
+		Run->SetNumberField(TEXT("Seconds"), Seconds);
+		Run->SetNumberField(TEXT("AssetsPerSecond"), Stats.Imported / FMath::Max(Seconds, 0.001));
+		Run->SetNumberField(TEXT("PeakMemoryMB"), (double)(Stats.PeakUsedPhysical / (1024 * 1024)));
+
+		TSharedRef<FJsonObject> Stages = MakeShared<FJsonObject>();
+		for (TPair<const TCHAR*, TArray<double>*> Stage : { MakeTuple(TEXT("Load"), &Load), MakeTuple(TEXT("Ready"), &Ready), MakeTuple(TEXT("Capture"), &Capture),
+			MakeTuple(TEXT("Process"), &Process), MakeTuple(TEXT("Import"), &Import), MakeTuple(TEXT("Total"), &Total) })
+		{
+			TSharedRef<FJsonObject> Latency = MakeShared<FJsonObject>();
+			Latency->SetNumberField(TEXT("P50Ms"), GetPercentileMs(*Stage.Value, 0.5));
+			Latency->SetNumberField(TEXT("P95Ms"), GetPercentileMs(*Stage.Value, 0.95));
+			Stages->SetObjectField(Stage.Key, Latency);
+		}
+		Run->SetObjectField(TEXT("Stages"), Stages);
+		Runs.Add(MakeShared<FJsonValueObject>(Run));
+
+		UE_LOG(LogThumbnailCreator, Display, TEXT("%dx%d: %d thumbnails in %.2fs (%.1f/s), p95 %.2fms, peak memory %llu MB"),
+			Size, Size, Stats.Imported, Seconds, Stats.Imported / FMath::Max(Seconds, 0.001), GetPercentileMs(Total, 0.95), Stats.PeakUsedPhysical / (1024 * 1024));
+
+		//Copies and their unsaved thumbnails go with the next collection
+		for (const FString& Thumbnail : Thumbnails)
+		{
+			if (UPackage* Package = FindPackage(nullptr, *(FString(FThumbnailImporter::ExportPath) + Thumbnail)))
+			{
+				ForEachObjectWithPackage(Package, [&Objects](UObject* Object)
+				{
+					Objects.Add(Object);
+					return true;
+				}, false);
+			}
+		}
+		for (UObject* Object : Objects)
+		{
+			Object->ClearFlags(RF_Standalone);
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Backend"), StaticEnum<EThumbnailCaptureBackend>()->GetNameStringByValue((int64)Options->CaptureBackend));
+	Root->SetNumberField(TEXT("Count"), Count);
+	Root->SetArrayField(TEXT("Runs"), Runs);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(Json, *OutputFile))
+	{
+		UE_LOG(LogThumbnailCreator, Error, TEXT("Could not write %s"), *OutputFile);
+		return 1;
+	}
+	UE_LOG(LogThumbnailCreator, Display, TEXT("Benchmark written to %s"), *OutputFile);
+
+	return bAnyFailed ? 1 : 0;
+}
+
+TArray<FAssetData> UThumbnailBenchmarkCommandlet::CreateBenchmarkAssets(int32 Count, int32 Size, TArray<UObject*>& OutObjects)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	USkeletalMesh* SkeletalCube = LoadObject<USkeletalMesh>(nullptr, TEXT("/Engine/EngineMeshes/SkeletalCube.SkeletalCube"));
+	UMaterialInterface* Material = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial"));
+
+	TArray<FAssetData> Assets;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		//Kinds interleaved, like a mixed content folder
+		for (UObject* Source : { (UObject*)Cube, (UObject*)SkeletalCube, (UObject*)Material })
+		{
+			if (!Source)
+			{
+				continue;
+			}
+
+			const FString Name = FString::Printf(TEXT("Bench_%s_%d_%d"), *Source->GetName(), Size, Index);
+			UPackage* Package = CreatePackage(*(TEXT("/Temp/ThumbnailBenchmark/") + Name));
+
+			//Material instances are distinct materials without compiling a copy of the parent
+			UObject* Copy = nullptr;
+			if (UMaterialInterface* Parent = Cast<UMaterialInterface>(Source))
+			{
+				UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(Package, *Name, RF_Public | RF_Standalone);
+				Instance->SetParentEditorOnly(Parent);
+				Copy = Instance;
+			}
+			else
+			{
+				Copy = DuplicateObject<UObject>(Source, Package, *Name);
+				Copy->SetFlags(RF_Public | RF_Standalone);
+			}
+
+			OutObjects.Add(Copy);
+			Assets.Emplace(Copy);
+		}
+	}
+	return Assets;
+}
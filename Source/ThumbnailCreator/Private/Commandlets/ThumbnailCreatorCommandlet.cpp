@@ -0,0 +1,172 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Commandlets/ThumbnailCreatorCommandlet.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Objects/ThumbnailOptions.h"
+#include "Pipeline/ThumbnailPipeline.h"
+
+//Engine
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetCompilingManager.h"
+#include "ContentStreaming.h"
+#include "Containers/Ticker.h"
+#include "RenderingThread.h"
+#include "ShaderCompiler.h"
+
+UThumbnailCreatorCommandlet::UThumbnailCreatorCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UThumbnailCreatorCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const FString* PathsParam = ParamsMap.Find(TEXT("Paths"));
+	if (!PathsParam)
+	{
+		UE_LOG(LogThumbnailCreator, Error, TEXT("Usage: -run=ThumbnailCreator -Paths=/Game/A+/Game/B [-Classes=StaticMesh+Material] [-Tags=Key:Value+Key] [-NonRecursive] [-<Option>=<Value>...]"));
+		return 1;
+	}
+
+	FThumbnailCreatorModule& Module = FModuleManager::LoadModuleChecked<FThumbnailCreatorModule>(TEXT("ThumbnailCreator"));
+	if (!Module.ThumbnailOptions)
+	{
+		Module.ThumbnailOptions = NewObject<UThumbnailOptions>(GetTransientPackage(), UThumbnailOptions::StaticClass());
+		Module.ThumbnailOptions->AddToRoot();
+	}
+
+	//There is no tab to capture with
+	Module.ThumbnailOptions->CaptureBackend = EThumbnailCaptureBackend::ScenePool;
+	ApplyOptionOverrides(Module.ThumbnailOptions, ParamsMap);
+
+	//Nobody is around to save by hand
+	if (Module.ThumbnailOptions->SaveGroupSize <= 0)
+	{
+		Module.ThumbnailOptions->SaveGroupSize = 64;
+	}
+
+	//Build the query
+	FARFilter Filter;
+	Filter.bRecursivePaths = !Switches.Contains(TEXT("NonRecursive"));
+	Filter.bRecursiveClasses = true;
+
+	TArray<FString> Paths;
+	PathsParam->ParseIntoArray(Paths, TEXT("+"));
+	for (const FString& PackagePath : Paths)
+	{
+		Filter.PackagePaths.Add(*PackagePath);
+	}
+
+	if (const FString* ClassesParam = ParamsMap.Find(TEXT("Classes")))
+	{
+		TArray<FString> ClassNames;
+		ClassesParam->ParseIntoArray(ClassNames, TEXT("+"));
+		for (const FString& ClassName : ClassNames)
+		{
+			UClass* Class = ClassName.Contains(TEXT(".")) ? FindObject<UClass>(nullptr, *ClassName) : UClass::TryFindTypeSlow<UClass>(ClassName);
+			if (!Class)
+			{
+				UE_LOG(LogThumbnailCreator, Error, TEXT("Unknown class %s"), *ClassName);
+				return 1;
+			}
+			Filter.ClassPaths.Add(Class->GetClassPathName());
+		}
+	}
+
+	//Key:Value pairs, a key without value matches any asset that has the tag
+	if (const FString* TagsParam = ParamsMap.Find(TEXT("Tags")))
+	{
+		TArray<FString> Tags;
+		TagsParam->ParseIntoArray(Tags, TEXT("+"));
+		for (const FString& Tag : Tags)
+		{
+			FString Key;
+			FString Value;
+			if (Tag.Split(TEXT(":"), &Key, &Value))
+			{
+				Filter.TagsAndValues.Add(*Key, Value);
+			}
+			else
+			{
+				Filter.TagsAndValues.Add(*Tag);
+			}
+		}
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	//Results are fetched a folder at a time while the pipeline drains
+	FThumbnailPipeline& Pipeline = Module.GetPipeline();
+	Pipeline.EnqueueQuery(Filter);
+	RunUntilIdle(Pipeline);
+
+	const FThumbnailPipelineStats& Stats = Pipeline.GetStats();
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogThumbnailCreator, Display, TEXT("Thumbnails: %d queued, %d skipped, %d unsupported, %d imported (%d unchanged), %d saved, %d failed in %.2fs (%.1f/s)"),
+		Stats.Queued, Stats.Skipped, Stats.Unsupported, Stats.Imported, Stats.Unchanged, Stats.Saved, Stats.Failed, Seconds, Stats.Imported / FMath::Max(Seconds, 0.001));
+	UE_LOG(LogThumbnailCreator, Display, TEXT("Peak memory %llu MB, %d garbage collections"), Stats.PeakUsedPhysical / (1024 * 1024), Stats.Collections);
+
+	return Stats.Failed > 0 ? 1 : 0;
+}
+
+void UThumbnailCreatorCommandlet::ApplyOptionOverrides(UThumbnailOptions* Options, const TMap<FString, FString>& ParamsMap)
+{
+	for (TFieldIterator<FProperty> It(UThumbnailOptions::StaticClass()); It; ++It)
+	{
+		const FString* Value = ParamsMap.Find(It->GetName());
+		if (!Value)
+		{
+			continue;
+		}
+
+		if (It->ImportText_InContainer(**Value, Options, Options, PPF_None))
+		{
+			UE_LOG(LogThumbnailCreator, Display, TEXT("%s = %s"), *It->GetName(), **Value);
+		}
+		else
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("Could not set %s to %s"), *It->GetName(), **Value);
+		}
+	}
+}
+
+void UThumbnailCreatorCommandlet::RunUntilIdle(FThumbnailPipeline& Pipeline)
+{
+	double LastTime = FPlatformTime::Seconds();
+	while (!Pipeline.IsIdle())
+	{
+		const double Now = FPlatformTime::Seconds();
+		const float DeltaTime = (float)(Now - LastTime);
+		LastTime = Now;
+
+		//Loads, compiles and streaming the readiness stage waits on
+		ProcessAsyncLoading(true, false, 0.01f);
+		FAssetCompilingManager::Get().ProcessAsyncTasks(true);
+		if (GShaderCompilingManager)
+		{
+			GShaderCompilingManager->ProcessAsyncResults(true, false);
+		}
+		IStreamingManager::Get().Tick(DeltaTime);
+
+		//Worker completions and the pump
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+
+		//No frames end here, submit the captures so their readbacks can finish
+		FlushRenderingCommands();
+	}
+}
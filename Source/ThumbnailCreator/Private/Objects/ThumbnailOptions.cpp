@@ -3,6 +3,61 @@
 
 #include "Objects/ThumbnailOptions.h"
 
+//Engine
+#include "ShowFlags.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkinnedMeshComponent.h"
 
+void FThumbnailCaptureProfile::ApplyToShowFlags(FEngineShowFlags& ShowFlags) const
+{
+	ShowFlags.SetDynamicShadows(bDynamicShadows);
+	ShowFlags.SetAmbientOcclusion(bAmbientOcclusion);
+	ShowFlags.SetScreenSpaceReflections(bScreenSpaceReflections);
+	ShowFlags.SetMotionBlur(bMotionBlur);
+}
 
+void FThumbnailCaptureProfile::ApplyToComponent(UPrimitiveComponent* Component) const
+{
+	if (UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+	{
+		StaticMeshComp->SetForcedLodModel(ForcedLod);
+	}
+	else if (USkinnedMeshComponent* SkinnedMeshComp = Cast<USkinnedMeshComponent>(Component))
+	{
+		SkinnedMeshComp->SetForcedLOD(ForcedLod);
+	}
+}
 
+UThumbnailOptions::UThumbnailOptions()
+{
+	//Icons: a lower LOD and no shadowing, the detail is lost at this size anyway
+	FThumbnailCaptureProfile& Icon = CaptureProfiles.AddDefaulted_GetRef();
+	Icon.MaxSize = 128;
+	Icon.ForcedLod = 2;
+	Icon.bDynamicShadows = false;
+	Icon.bAmbientOcclusion = false;
+	Icon.bScreenSpaceReflections = false;
+
+	//Regular thumbnails: full detail mesh, no reflections
+	FThumbnailCaptureProfile& Thumbnail = CaptureProfiles.AddDefaulted_GetRef();
+	Thumbnail.MaxSize = 512;
+	Thumbnail.ForcedLod = 1;
+	Thumbnail.bScreenSpaceReflections = false;
+}
+
+const FThumbnailCaptureProfile& UThumbnailOptions::GetCaptureProfile() const
+{
+	const int32 Size = FMath::Max(ScreenshotXSize, ScreenshotYSize);
+
+	const FThumbnailCaptureProfile* Best = nullptr;
+	for (const FThumbnailCaptureProfile& Profile : CaptureProfiles)
+	{
+		if (Profile.MaxSize >= Size && (!Best || Profile.MaxSize < Best->MaxSize))
+		{
+			Best = &Profile;
+		}
+	}
+
+	static const FThumbnailCaptureProfile FullQuality;
+	return Best ? *Best : FullQuality;
+}
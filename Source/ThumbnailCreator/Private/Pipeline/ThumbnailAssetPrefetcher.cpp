@@ -0,0 +1,118 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailAssetPrefetcher.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+
+//Engine
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/AnimationAsset.h"
+#include "Materials/MaterialInterface.h"
+
+DECLARE_CYCLE_STAT(TEXT("Asset Load Request"), STAT_ThumbnailLoadRequest, STATGROUP_ThumbnailCreator);
+
+UObject* FThumbnailPrefetchedAsset::GetAsset() const
+{
+	return Handle.IsValid() ? Handle->GetLoadedAsset() : nullptr;
+}
+
+//Map an asset class onto the thumbnail type that can show it
+static EThumbnailAssetType GetAssetTypeOfClass(const UClass* Class)
+{
+	if (!Class)
+	{
+		return EThumbnailAssetType::Unsupported;
+	}
+	if (Class->IsChildOf(UStaticMesh::StaticClass()))
+	{
+		return EThumbnailAssetType::StaticMesh;
+	}
+	if (Class->IsChildOf(USkeletalMesh::StaticClass()))
+	{
+		return EThumbnailAssetType::SkeletalMesh;
+	}
+	if (Class->IsChildOf(UAnimationAsset::StaticClass()))
+	{
+		return EThumbnailAssetType::Animation;
+	}
+	if (Class->IsChildOf(UMaterialInterface::StaticClass()))
+	{
+		return EThumbnailAssetType::Material;
+	}
+	return EThumbnailAssetType::Unsupported;
+}
+
+EThumbnailAssetType FThumbnailAssetPrefetcher::ResolveAssetType(const FAssetData& Data)
+{
+	//Looks up the class from AssetClassPath, the asset itself stays on disk
+	return GetAssetTypeOfClass(Data.GetClass());
+}
+
+bool FThumbnailAssetPrefetcher::Enqueue(const FAssetData& Data)
+{
+	FThumbnailPrefetchedAsset Asset;
+	Asset.Type = ResolveAssetType(Data);
+	if (Asset.Type == EThumbnailAssetType::Unsupported)
+	{
+		return false;
+	}
+
+	Asset.Data = Data;
+	Queued.Enqueue(MoveTemp(Asset));
+	++NumQueued;
+	return true;
+}
+
+void FThumbnailAssetPrefetcher::Update(int32 LookAhead, FSimpleDelegate OnLoaded)
+{
+	THUMBNAIL_SCOPE(STAT_ThumbnailLoadRequest);
+
+	while (NumRequested < LookAhead && NumQueued > 0)
+	{
+		FThumbnailPrefetchedAsset Asset;
+		Queued.Dequeue(Asset);
+		--NumQueued;
+
+		Asset.bWasLoaded = FindPackage(nullptr, *Asset.Data.PackageName.ToString()) != nullptr;
+		Asset.RequestTime = FPlatformTime::Seconds();
+		Asset.Handle = StreamableManager.RequestAsyncLoad(Asset.Data.GetSoftObjectPath(), OnLoaded, FStreamableManager::AsyncLoadHighPriority);
+		Requested.Enqueue(MoveTemp(Asset));
+		++NumRequested;
+	}
+}
+
+bool FThumbnailAssetPrefetcher::PopLoaded(FThumbnailPrefetchedAsset& OutAsset)
+{
+	FThumbnailPrefetchedAsset* Next = Requested.Peek();
+	if (!Next)
+	{
+		return false;
+	}
+
+	//Keep queue order, a later asset that finished first waits for this one
+	if (Next->Handle.IsValid() && !Next->Handle->HasLoadCompleted())
+	{
+		return false;
+	}
+
+	Requested.Dequeue(OutAsset);
+	--NumRequested;
+	return true;
+}
+
+void FThumbnailAssetPrefetcher::Empty()
+{
+	FThumbnailPrefetchedAsset Asset;
+	while (Requested.Dequeue(Asset))
+	{
+		if (Asset.Handle.IsValid())
+		{
+			Asset.Handle->CancelHandle();
+		}
+	}
+	Queued.Empty();
+	NumQueued = 0;
+	NumRequested = 0;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailAssetQuery.h"
+
+//Engine
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+FThumbnailAssetQuery::FThumbnailAssetQuery(const FARFilter& InFilter)
+	: Filter(InFilter)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//Without paths every folder the registry knows is queried
+	TArray<FString> Paths;
+	if (InFilter.PackagePaths.Num() == 0)
+	{
+		AssetRegistry.GetAllCachedPaths(Paths);
+	}
+	else
+	{
+		for (const FName& PackagePath : InFilter.PackagePaths)
+		{
+			Paths.Add(PackagePath.ToString());
+			if (InFilter.bRecursivePaths)
+			{
+				AssetRegistry.GetSubPaths(PackagePath.ToString(), Paths, true);
+			}
+		}
+	}
+
+	TSet<FName> Unique;
+	for (const FString& Path : Paths)
+	{
+		bool bAlreadyAdded = false;
+		Unique.Add(*Path, &bAlreadyAdded);
+		if (!bAlreadyAdded)
+		{
+			Folders.Add(*Path);
+		}
+	}
+
+	Filter.PackagePaths.Reset();
+	Filter.bRecursivePaths = false;
+}
+
+bool FThumbnailAssetQuery::NextPage(TArray<FAssetData>& OutAssets)
+{
+	OutAssets.Reset();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	while (FolderCursor > 0 || NextFolder < Folders.Num())
+	{
+		//Continue the folder of the last page or start the next one
+		if (FolderCursor == 0)
+		{
+			Filter.PackagePaths.Reset();
+			Filter.PackagePaths.Add(Folders[NextFolder++]);
+		}
+
+		//Skip what earlier pages handed out and stop once the page is full, the folder is never copied as a whole
+		int32 Index = 0;
+		bool bFolderDone = true;
+		AssetRegistry.EnumerateAssets(Filter, [this, &OutAssets, &Index, &bFolderDone](const FAssetData& Data)
+		{
+			if (Index++ < FolderCursor)
+			{
+				return true;
+			}
+			if (OutAssets.Num() == PageSize)
+			{
+				bFolderDone = false;
+				return false;
+			}
+			OutAssets.Add(Data);
+			return true;
+		});
+		FolderCursor = bFolderDone ? 0 : FolderCursor + OutAssets.Num();
+
+		if (OutAssets.Num() > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,210 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailCache.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Objects/ThumbnailOptions.h"
+#include "Pipeline/ThumbnailImporter.h"
+#include "Pipeline/ThumbnailResampler.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+
+//Engine
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetPackageData.h"
+#include "AssetViewerSettings.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+//Bump when the file layout or the key changes, older caches are thrown away
+static const int32 ThumbnailCacheVersion = 2;
+
+static FString GetCacheFile()
+{
+	return FPaths::ProjectSavedDir() + TEXT("ThumbnailCreator/ThumbnailCache.bin");
+}
+
+FThumbnailCache::~FThumbnailCache()
+{
+	Flush();
+}
+
+uint64 FThumbnailCache::HashOptions(const UThumbnailOptions& Options, int32 ProfileIndex, const FThumbnailCaptureView* ManualView)
+{
+	FXxHash64Builder Builder;
+	auto Add = [&Builder](const auto& Value) { Builder.Update(&Value, sizeof(Value)); };
+
+	Add(Options.ScreenshotXSize);
+	Add(Options.ScreenshotYSize);
+	Add(Options.bUseAutoSize);
+	Add(Options.ThumbnailPitch);
+	Add(Options.ThumbnailYaw);
+	Add(Options.ThumbnailZoom);
+	Add(Options.FOV);
+	Add(Options.CaptureBackend);
+
+	//Without auto size every backend shoots from wherever the viewport camera was left
+	if (!Options.bUseAutoSize && ManualView)
+	{
+		Add(ManualView->Location);
+		Add(ManualView->Rotation);
+		Add(ManualView->FOV);
+	}
+
+	Add(Options.bAutoCrop);
+	if (Options.bAutoCrop)
+	{
+		Add(Options.AutoCropPadding);
+		Add(Options.AutoCropAlphaThreshold);
+	}
+
+	for (int32 Size : Options.ExtraOutputSizes)
+	{
+		Add(Size);
+	}
+
+	const FThumbnailCaptureProfile& CaptureProfile = Options.GetCaptureProfile();
+	Add(CaptureProfile.ForcedLod);
+	Add(CaptureProfile.Supersample);
+	Add(CaptureProfile.bDynamicShadows);
+	Add(CaptureProfile.bAmbientOcclusion);
+	Add(CaptureProfile.bScreenSpaceReflections);
+	Add(CaptureProfile.bMotionBlur);
+
+	//Lighting, environment and post process of the preview profile
+	const UAssetViewerSettings* ViewerSettings = UAssetViewerSettings::Get();
+	if (ViewerSettings && ViewerSettings->Profiles.IsValidIndex(ProfileIndex))
+	{
+		FString ProfileText;
+		FPreviewSceneProfile::StaticStruct()->ExportText(ProfileText, &ViewerSettings->Profiles[ProfileIndex], nullptr, nullptr, PPF_None, nullptr);
+		Builder.Update(*ProfileText, ProfileText.Len() * sizeof(TCHAR));
+	}
+
+	return Builder.Finalize().Hash;
+}
+
+uint64 FThumbnailCache::MakeKey(const FAssetData& Data, uint64 OptionsHash)
+{
+	//Unsaved edits are not in the saved hash
+	const UPackage* LoadedPackage = FindPackage(nullptr, *Data.PackageName.ToString());
+	if (LoadedPackage && LoadedPackage->IsDirty())
+	{
+		return 0;
+	}
+
+	FAssetPackageData PackageData;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.TryGetAssetPackageData(Data.PackageName, PackageData) != UE::AssetRegistry::EExists::Exists || PackageData.PackageSavedHash.IsZero())
+	{
+		return 0;
+	}
+
+	FXxHash64Builder Builder;
+	Builder.Update(&PackageData.PackageSavedHash, sizeof(PackageData.PackageSavedHash));
+	Builder.Update(&OptionsHash, sizeof(OptionsHash));
+	return FMath::Max<uint64>(Builder.Finalize().Hash, 1);
+}
+
+bool FThumbnailCache::IsUpToDate(const FAssetData& Data, uint64 Key, const UThumbnailOptions& Options)
+{
+	if (Key == 0)
+	{
+		return false;
+	}
+
+	Load();
+
+	const FRecord* Found = Records.Find(Data.GetObjectPathString());
+	if (!Found || Found->Key != Key)
+	{
+		return false;
+	}
+
+	//Deleted thumbnails are generated again, also when only one of the smaller sizes is gone
+	if (!DoesTextureExist(Found->TextureName))
+	{
+		return false;
+	}
+	const FIntPoint OutputSize(Options.ScreenshotXSize, Options.ScreenshotYSize);
+	for (int32 Size : Options.ExtraOutputSizes)
+	{
+		if (FThumbnailResampler::CanReduceTo(OutputSize, Size) && !DoesTextureExist(FString::Printf(TEXT("%s_%d"), *Found->TextureName, Size)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FThumbnailCache::DoesTextureExist(const FString& TextureName)
+{
+	const FString TexturePackage = FString(FThumbnailImporter::ExportPath) + TextureName;
+	return FindPackage(nullptr, *TexturePackage) || FPackageName::DoesPackageExist(TexturePackage);
+}
+
+void FThumbnailCache::Record(const FString& AssetPath, uint64 Key, const FString& TextureName)
+{
+	if (Key == 0 || AssetPath.IsEmpty())
+	{
+		return;
+	}
+
+	Load();
+
+	FRecord& Entry = Records.FindOrAdd(AssetPath);
+	Entry.Key = Key;
+	Entry.TextureName = TextureName;
+	bDirty = true;
+}
+
+void FThumbnailCache::Load()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetCacheFile(), FILEREAD_Silent));
+	if (!Reader)
+	{
+		return;
+	}
+
+	int32 Version = 0;
+	*Reader << Version;
+	if (Version != ThumbnailCacheVersion)
+	{
+		return;
+	}
+
+	*Reader << Records;
+	if (Reader->IsError())
+	{
+		UE_LOG(LogThumbnailCreator, Warning, TEXT("Thumbnail cache %s is corrupt, every asset will be captured again"), *GetCacheFile());
+		Records.Empty();
+	}
+}
+
+void FThumbnailCache::Flush()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+	bDirty = false;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetCacheFile()));
+	if (!Writer)
+	{
+		UE_LOG(LogThumbnailCreator, Warning, TEXT("Could not write the thumbnail cache to %s"), *GetCacheFile());
+		return;
+	}
+
+	int32 Version = ThumbnailCacheVersion;
+	*Writer << Version;
+	*Writer << Records;
+}
@@ -0,0 +1,246 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailCaptureScene.h"
+
+//Thumbnail Core
+#include "Objects/ThumbnailOptions.h"
+#include "Pipeline/ThumbnailAssetPrefetcher.h"
+
+//Engine
+#include "Editor/AdvancedPreviewScene/Public/AdvancedPreviewScene.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/PostProcessComponent.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/AnimationAsset.h"
+#include "Animation/Skeleton.h"
+#include "Materials/MaterialInterface.h"
+#include "TextureResource.h"
+
+FThumbnailCaptureScene::FThumbnailCaptureScene(int32 ProfileIndex)
+	: PreviewScene(MakeUnique<FAdvancedPreviewScene>(FPreviewScene::ConstructionValues()))
+{
+	PreviewScene->SetProfileIndex(ProfileIndex);
+
+	MeshComp = NewObject<UStaticMeshComponent>();
+	SkelMeshComp = NewObject<USkeletalMeshComponent>();
+	MaterialComp = NewObject<UStaticMeshComponent>();
+	PostComp = NewObject<UPostProcessComponent>();
+	CaptureComp = NewObject<USceneCaptureComponent2D>();
+
+	//Same material preview mesh as the viewport
+	UStaticMesh* MaterialMesh = Cast<UStaticMesh>(StaticLoadObject(UStaticMesh::StaticClass(), NULL, *(FString("StaticMesh'/Engine/EngineMeshes/MaterialSphere.MaterialSphere'"))));
+	if (MaterialMesh)
+	{
+		MaterialComp->SetStaticMesh(MaterialMesh);
+	}
+
+	//Same post process as the viewport, supersampling is done by capturing larger and filtering down on a worker
+	PostComp->Settings.ScreenPercentage_DEPRECATED = 100;
+	PostComp->bUnbound = true;
+
+	for (UPrimitiveComponent* Comp : { (UPrimitiveComponent*)MeshComp, (UPrimitiveComponent*)SkelMeshComp, (UPrimitiveComponent*)MaterialComp })
+	{
+		Comp->SetVisibility(false);
+		PreviewScene->AddComponent(Comp, FTransform(), false);
+	}
+	PreviewScene->AddComponent(PostComp, FTransform(), false);
+
+	RenderTarget = NewObject<UTextureRenderTarget2D>();
+	RenderTarget->ClearColor = FLinearColor::Transparent;
+	RenderTarget->InitCustomFormat(512, 512, PF_B8G8R8A8, false);
+
+	//Only the asset is rendered, the floor and sky of the preview scene only contribute lighting
+	CaptureComp->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList;
+	CaptureComp->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+	CaptureComp->bCaptureEveryFrame = false;
+	CaptureComp->bCaptureOnMovement = false;
+	CaptureComp->bAlwaysPersistRenderingState = true;
+	CaptureComp->TextureTarget = RenderTarget;
+	PreviewScene->AddComponent(CaptureComp, FTransform(), false);
+
+	//Scene color keeps the inverse opacity in alpha no matter the project settings, unlit as only the coverage is used
+	MaskCaptureComp = NewObject<USceneCaptureComponent2D>();
+	MaskTarget = NewObject<UTextureRenderTarget2D>();
+	MaskTarget->ClearColor = FLinearColor::Black;
+	MaskTarget->InitCustomFormat(512, 512, PF_FloatRGBA, true);
+
+	MaskCaptureComp->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList;
+	MaskCaptureComp->CaptureSource = ESceneCaptureSource::SCS_SceneColorHDR;
+	MaskCaptureComp->bCaptureEveryFrame = false;
+	MaskCaptureComp->bCaptureOnMovement = false;
+	MaskCaptureComp->bAlwaysPersistRenderingState = true;
+	MaskCaptureComp->TextureTarget = MaskTarget;
+	MaskCaptureComp->ShowFlags.SetLighting(false);
+	MaskCaptureComp->ShowFlags.SetDynamicShadows(false);
+	MaskCaptureComp->ShowFlags.SetAmbientOcclusion(false);
+	MaskCaptureComp->ShowFlags.SetScreenSpaceReflections(false);
+	PreviewScene->AddComponent(MaskCaptureComp, FTransform(), false);
+}
+
+FThumbnailCaptureScene::~FThumbnailCaptureScene()
+{
+	PreviewScene.Reset();
+}
+
+bool FThumbnailCaptureScene::SetAsset(UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options)
+{
+	ActiveComp = nullptr;
+	ActiveAsset = Asset;
+
+	switch (Type)
+	{
+	case EThumbnailAssetType::StaticMesh:
+		MeshComp->SetStaticMesh(CastChecked<UStaticMesh>(Asset));
+		ActiveComp = MeshComp;
+		break;
+
+	case EThumbnailAssetType::SkeletalMesh:
+		SkelMeshComp->SetSkeletalMesh(CastChecked<USkeletalMesh>(Asset));
+		ActiveComp = SkelMeshComp;
+		break;
+
+	case EThumbnailAssetType::Animation:
+	{
+		//Animations are shown on the preview mesh of their skeleton
+		UAnimationAsset* AnimationAsset = CastChecked<UAnimationAsset>(Asset);
+		USkeletalMesh* PreviewMesh = AnimationAsset->GetSkeleton() ? AnimationAsset->GetSkeleton()->GetPreviewMesh() : nullptr;
+		if (!PreviewMesh)
+		{
+			break;
+		}
+		SkelMeshComp->SetSkeletalMesh(PreviewMesh);
+		SkelMeshComp->PlayAnimation(AnimationAsset, true);
+		ActiveComp = SkelMeshComp;
+		break;
+	}
+
+	case EThumbnailAssetType::Material:
+		MaterialComp->SetMaterial(0, CastChecked<UMaterialInterface>(Asset));
+		ActiveComp = MaterialComp;
+		break;
+
+	default:
+		break;
+	}
+
+	//go over all components and only show the one we want to activate
+	for (UPrimitiveComponent* Comp : { (UPrimitiveComponent*)MeshComp, (UPrimitiveComponent*)SkelMeshComp, (UPrimitiveComponent*)MaterialComp })
+	{
+		Comp->SetVisibility(Comp == ActiveComp);
+	}
+
+	if (!ActiveComp)
+	{
+		ActiveAsset = nullptr;
+		return false;
+	}
+
+	//Nothing ticks this world, pose skeletal meshes by hand
+	if (ActiveComp == SkelMeshComp)
+	{
+		SkelMeshComp->TickAnimation(0.f, false);
+		SkelMeshComp->RefreshBoneTransforms();
+	}
+
+	//LOD is picked before the readiness wait so only the LOD that is rendered has to stream in, the material sphere keeps its own
+	if (ActiveComp != MaterialComp)
+	{
+		Options.GetCaptureProfile().ApplyToComponent(ActiveComp);
+	}
+
+	ActiveComp->SetRenderCustomDepth(true);
+	ActiveComp->UpdateBounds();
+	ActiveComp->MarkRenderStateDirty();
+	return true;
+}
+
+TUniquePtr<FThumbnailGPUReadback> FThumbnailCaptureScene::Capture(const UThumbnailOptions& Options, const TOptional<FThumbnailCaptureView>& ManualView)
+{
+	FThumbnailImage Image;
+	Image.AssetName = "Thumb_" + GetAssetName();
+	const FThumbnailCaptureProfile& Profile = Options.GetCaptureProfile();
+	Image.Supersample = FMath::Max(1, Profile.Supersample);
+	Image.Size = FIntPoint(Options.ScreenshotXSize, Options.ScreenshotYSize) * Image.Supersample;
+
+	if (!ActiveComp || Image.Size.X <= 0 || Image.Size.Y <= 0)
+	{
+		return nullptr;
+	}
+
+	for (UTextureRenderTarget2D* Target : { RenderTarget.Get(), MaskTarget.Get() })
+	{
+		if (Target->SizeX != Image.Size.X || Target->SizeY != Image.Size.Y)
+		{
+			Target->ResizeTarget(Image.Size.X, Image.Size.Y);
+		}
+	}
+
+	UpdateCaptureTransform(Options, ManualView);
+
+	Profile.ApplyToShowFlags(CaptureComp->ShowFlags);
+
+	for (USceneCaptureComponent2D* Comp : { CaptureComp.Get(), MaskCaptureComp.Get() })
+	{
+		Comp->ShowOnlyComponents.Reset();
+		Comp->ShowOnlyComponents.Add(ActiveComp);
+	}
+
+	//Push the new asset to the render thread before the capture is enqueued
+	PreviewScene->GetWorld()->SendAllEndOfFrameUpdates();
+	CaptureComp->CaptureScene();
+	MaskCaptureComp->CaptureScene();
+
+	FTextureRenderTargetResource* Resource = RenderTarget->GameThread_GetRenderTargetResource();
+	FTextureRenderTargetResource* MaskResource = MaskTarget->GameThread_GetRenderTargetResource();
+	if (!Resource || !MaskResource)
+	{
+		return nullptr;
+	}
+	return MakeUnique<FThumbnailGPUReadback>(Resource, MoveTemp(Image), MaskResource);
+}
+
+FString FThumbnailCaptureScene::GetAssetName() const
+{
+	return ActiveAsset ? ActiveAsset->GetName() : FString();
+}
+
+void FThumbnailCaptureScene::UpdateCaptureTransform(const UThumbnailOptions& Options, const TOptional<FThumbnailCaptureView>& ManualView)
+{
+	FThumbnailCaptureView View;
+	if (!Options.bUseAutoSize && ManualView.IsSet())
+	{
+		//Without auto size the viewport shoots from wherever its camera was left
+		View = ManualView.GetValue();
+	}
+	else
+	{
+		const FBoxSphereBounds Bounds = ActiveComp->Bounds;
+		View.Rotation = FRotator(Options.ThumbnailPitch, Options.ThumbnailYaw, 0);
+		View.Location = Bounds.Origin - View.Rotation.Vector() * (Bounds.SphereRadius * 4 + Options.ThumbnailZoom);
+		View.FOV = Options.FOV;
+	}
+
+	for (USceneCaptureComponent2D* Comp : { CaptureComp.Get(), MaskCaptureComp.Get() })
+	{
+		Comp->FOVAngle = View.FOV;
+		Comp->SetWorldLocationAndRotation(View.Location, View.Rotation);
+	}
+}
+
+void FThumbnailCaptureScene::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(MeshComp);
+	Collector.AddReferencedObject(SkelMeshComp);
+	Collector.AddReferencedObject(MaterialComp);
+	Collector.AddReferencedObject(PostComp);
+	Collector.AddReferencedObject(CaptureComp);
+	Collector.AddReferencedObject(RenderTarget);
+	Collector.AddReferencedObject(MaskCaptureComp);
+	Collector.AddReferencedObject(MaskTarget);
+	Collector.AddReferencedObject(ActiveComp);
+	Collector.AddReferencedObject(ActiveAsset);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailGPUReadback.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+
+//Render
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "Math/Float16Color.h"
+
+DECLARE_CYCLE_STAT(TEXT("Readback Copy"), STAT_ThumbnailReadbackCopy, STATGROUP_ThumbnailCreator);
+
+FThumbnailGPUReadback::FThumbnailGPUReadback(FTextureRenderTargetResource* Resource, FThumbnailImage&& InImage, FTextureRenderTargetResource* MaskResource)
+	: State(MakeShared<FState, ESPMode::ThreadSafe>())
+{
+	State->Image = MoveTemp(InImage);
+	State->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("ThumbnailCapture"));
+	if (MaskResource)
+	{
+		State->MaskReadback = MakeUnique<FRHIGPUTextureReadback>(TEXT("ThumbnailCaptureMask"));
+	}
+
+	//Ordered behind the capture, later captures into the same target can't overwrite what is copied here
+	ENQUEUE_RENDER_COMMAND(ThumbnailEnqueueReadback)(
+		[State = State, Resource, MaskResource](FRHICommandListImmediate& RHICmdList)
+		{
+			State->Readback->EnqueueCopy(RHICmdList, Resource->GetRenderTargetTexture());
+			if (MaskResource)
+			{
+				State->MaskReadback->EnqueueCopy(RHICmdList, MaskResource->GetRenderTargetTexture());
+			}
+		});
+}
+
+bool FThumbnailGPUReadback::Poll(FThumbnailImage& OutImage)
+{
+	if (State->bCopied)
+	{
+		OutImage = MoveTemp(State->Image);
+		return true;
+	}
+
+	//Staging buffer is only mapped once the gpu is done with it, so the lock never stalls
+	if (!State->bCopyRequested && State->Readback->IsReady() && (!State->MaskReadback || State->MaskReadback->IsReady()))
+	{
+		State->bCopyRequested = true;
+
+		ENQUEUE_RENDER_COMMAND(ThumbnailCopyReadback)(
+			[State = State](FRHICommandListImmediate& RHICmdList)
+			{
+				THUMBNAIL_SCOPE(STAT_ThumbnailReadbackCopy);
+
+				FThumbnailImage& Image = State->Image;
+				Image.Pixels.SetNumUninitialized(Image.Size.X * Image.Size.Y);
+
+				int32 RowPitchInPixels = 0;
+				const FColor* Source = static_cast<const FColor*>(State->Readback->Lock(RowPitchInPixels));
+				if (Source)
+				{
+					//Rows of the staging buffer can be padded
+					for (int32 Y = 0; Y < Image.Size.Y; ++Y)
+					{
+						FMemory::Memcpy(&Image.Pixels[Y * Image.Size.X], Source + Y * RowPitchInPixels, Image.Size.X * sizeof(FColor));
+					}
+					State->Readback->Unlock();
+				}
+				else
+				{
+					Image.Pixels.Empty();
+				}
+
+				//Coverage of the scene color replaces whatever alpha the final color carries
+				if (State->MaskReadback && Image.Pixels.Num() > 0)
+				{
+					const FFloat16Color* Mask = static_cast<const FFloat16Color*>(State->MaskReadback->Lock(RowPitchInPixels));
+					if (Mask)
+					{
+						for (int32 Y = 0; Y < Image.Size.Y; ++Y)
+						{
+							const FFloat16Color* MaskRow = Mask + Y * RowPitchInPixels;
+							FColor* Row = &Image.Pixels[Y * Image.Size.X];
+							for (int32 X = 0; X < Image.Size.X; ++X)
+							{
+								const float Opacity = 1.f - FMath::Clamp(MaskRow[X].A.GetFloat(), 0.f, 1.f);
+								Row[X].A = (uint8)FMath::RoundToInt(Opacity * 255.f);
+							}
+						}
+						State->MaskReadback->Unlock();
+					}
+					else
+					{
+						Image.Pixels.Empty();
+					}
+				}
+
+				State->bCopied = true;
+			});
+	}
+
+	return false;
+}
@@ -0,0 +1,116 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailImporter.h"
+
+//Thumbnail Core
+#include "Pipeline/ThumbnailImage.h"
+
+//Engine
+#include "Engine/Texture2D.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+const TCHAR* FThumbnailImporter::ExportPath = TEXT("/Game/ThumbnailExports/");
+
+UTexture2D* FThumbnailImporter::ImportTexture(const FThumbnailImage& Image, int32 Tolerance, bool& bOutExistingAsset, bool& bOutUnchanged)
+{
+	bOutExistingAsset = false;
+	bOutUnchanged = false;
+
+	if (Image.Pixels.Num() != Image.Size.X * Image.Size.Y || Image.Pixels.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FString PackageName = FString(ExportPath) + Image.AssetName;
+
+	//Find the package in memory first, only hit the disk when it was saved before
+	UPackage* Package = FindPackage(nullptr, *PackageName);
+	if (!Package && FPackageName::DoesPackageExist(PackageName))
+	{
+		Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	}
+	if (!Package)
+	{
+		Package = CreatePackage(*PackageName);
+	}
+	Package->FullyLoad();
+
+	UTexture2D* Texture = FindObject<UTexture2D>(Package, *Image.AssetName);
+	bOutExistingAsset = Texture != nullptr;
+
+	//Same pixels, don't rebuild the texture or dirty the package
+	if (Texture && IsSourceUnchanged(Texture, Image, Tolerance))
+	{
+		bOutUnchanged = true;
+		return Texture;
+	}
+
+	if (Texture)
+	{
+		Texture->PreEditChange(nullptr);
+	}
+	else
+	{
+		Texture = NewObject<UTexture2D>(Package, *Image.AssetName, RF_Standalone | RF_Public | RF_Transactional);
+
+		//Set settings to fit with UI, existing textures keep whatever the user changed them to
+		Texture->Filter = TextureFilter::TF_Trilinear;
+		//2D pixels for UI gives clearest results
+		Texture->LODGroup = TextureGroup::TEXTUREGROUP_UI;
+		//Add chroma key
+		Texture->bChromaKeyTexture = true;
+		Texture->ChromaKeyColor = FColor(0, 255, 0, 0);
+	}
+
+	//Pixels are already BGRA, they become the source as they are
+	Texture->Source.Init(Image.Size.X, Image.Size.Y, 1, 1, TSF_BGRA8, reinterpret_cast<const uint8*>(Image.Pixels.GetData()));
+
+	//Single rebuild with the source and the settings applied
+	Texture->PostEditChange();
+
+	return Texture;
+}
+
+bool FThumbnailImporter::IsSourceUnchanged(UTexture2D* Texture, const FThumbnailImage& Image, int32 Tolerance)
+{
+	FTextureSource& Source = Texture->Source;
+	if (!Source.IsValid() || Source.GetFormat() != TSF_BGRA8 || Source.GetSizeX() != Image.Size.X || Source.GetSizeY() != Image.Size.Y || Source.GetNumSlices() != 1)
+	{
+		return false;
+	}
+
+	const int64 NumBytes = Image.Pixels.Num() * sizeof(FColor);
+	const uint8* SourceData = Source.LockMipReadOnly(0);
+	const bool bEqual = SourceData && ArePixelsEqual(SourceData, reinterpret_cast<const uint8*>(Image.Pixels.GetData()), NumBytes, Tolerance);
+	Source.UnlockMip(0);
+
+	return bEqual;
+}
+
+bool FThumbnailImporter::ArePixelsEqual(const uint8* A, const uint8* B, int64 NumBytes, int32 Tolerance)
+{
+	if (Tolerance <= 0)
+	{
+		return FMemory::Memcmp(A, B, NumBytes) == 0;
+	}
+
+	//Blocks without branches inside so the compiler vectorizes them, bail out between blocks
+	static const int64 BlockSize = 4096;
+	for (int64 Start = 0; Start < NumBytes; Start += BlockSize)
+	{
+		const int64 End = FMath::Min(Start + BlockSize, NumBytes);
+		uint8 MaxDiff = 0;
+		for (int64 Index = Start; Index < End; ++Index)
+		{
+			const uint8 Diff = A[Index] > B[Index] ? A[Index] - B[Index] : B[Index] - A[Index];
+			MaxDiff = MaxDiff > Diff ? MaxDiff : Diff;
+		}
+
+		if (MaxDiff > Tolerance)
+		{
+			return false;
+		}
+	}
+	return true;
+}
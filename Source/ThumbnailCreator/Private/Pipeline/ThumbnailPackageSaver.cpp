@@ -0,0 +1,177 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailPackageSaver.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+
+//Engine
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "Logging/MessageLog.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save"), STAT_ThumbnailSave, STATGROUP_ThumbnailCreator);
+
+void FThumbnailPackageSaver::Add(UPackage* Package, bool bWasLoaded)
+{
+	Pending.Enqueue(TPair<TWeakObjectPtr<UPackage>, bool>(Package, bWasLoaded));
+	++NumPending;
+}
+
+void FThumbnailPackageSaver::AddUnloadCandidate(UPackage* Package)
+{
+	if (bTrackUnloads)
+	{
+		UnloadCandidates.Add(Package);
+	}
+}
+
+void FThumbnailPackageSaver::SetTrackUnloads(bool bInTrackUnloads)
+{
+	bTrackUnloads = bInTrackUnloads;
+	if (!bTrackUnloads)
+	{
+		UnloadCandidates.Empty();
+	}
+}
+
+bool FThumbnailPackageSaver::SaveNext()
+{
+	TPair<TWeakObjectPtr<UPackage>, bool> Entry;
+	if (!Pending.Dequeue(Entry))
+	{
+		return false;
+	}
+	--NumPending;
+
+	UPackage* Package = Entry.Key.Get();
+	if (!Package || !Package->IsDirty())
+	{
+		return false;
+	}
+
+	THUMBNAIL_SCOPE(STAT_ThumbnailSave);
+
+	const FString Filename = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()));
+
+	//Read only workspaces need the file checked out first, build machines handle source control themselves
+	const bool bUseSourceControl = !IsRunningCommandlet() && ISourceControlModule::Get().IsEnabled();
+	const bool bNewFile = !IFileManager::Get().FileExists(*Filename);
+	if (bUseSourceControl && !bNewFile && !USourceControlHelpers::CheckOutOrAddFile(Filename, true))
+	{
+		UE_LOG(LogThumbnailCreator, Warning, TEXT("Could not check out %s, saving anyway"), *Filename);
+	}
+
+	//Serialization stays on the game thread, the file write is handed to a background task
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+	const FSavePackageResultStruct Result = UPackage::Save(Package, nullptr, *Filename, SaveArgs);
+	if (Result.Result != ESavePackageResult::Success)
+	{
+		UE_LOG(LogThumbnailCreator, Error, TEXT("Could not save %s"), *Package->GetName());
+		if (!IsRunningCommandlet())
+		{
+			FMessageLog("EditorErrors").Error(FText::FromString(FString::Printf(TEXT("Thumbnail Creator could not save %s, is the file read only or not checked out?"), *Package->GetName())));
+		}
+		++NumFailed;
+		return false;
+	}
+
+	if (bUseSourceControl && bNewFile)
+	{
+		NewFiles.Add(Filename);
+	}
+	INC_DWORD_STAT_BY(STAT_ThumbnailBytesWritten, Result.TotalFileSize);
+
+	if (!Entry.Value)
+	{
+		AddUnloadCandidate(Package);
+	}
+	return true;
+}
+
+int32 FThumbnailPackageSaver::SaveGroup()
+{
+	int32 NumSaved = 0;
+	while (NumPending > 0)
+	{
+		NumSaved += SaveNext() ? 1 : 0;
+	}
+
+	//Packages collected by someone else don't have to be remembered until the next release
+	UnloadCandidates.RemoveAllSwap([](const TWeakObjectPtr<UPackage>& Candidate) { return !Candidate.IsValid(); });
+	return NumSaved;
+}
+
+void FThumbnailPackageSaver::FinishWrites()
+{
+	UPackage::WaitForAsyncFileWrites();
+
+	//Only files that are on disk can be added
+	if (NewFiles.Num() > 0)
+	{
+		if (!USourceControlHelpers::MarkFilesForAdd(NewFiles, true))
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("Could not mark %d new thumbnails for add"), NewFiles.Num());
+		}
+		NewFiles.Reset();
+	}
+}
+
+int32 FThumbnailPackageSaver::TakeNumFailed()
+{
+	const int32 Failed = NumFailed;
+	NumFailed = 0;
+	if (Failed > 0 && !IsRunningCommandlet())
+	{
+		FMessageLog("EditorErrors").Notify(FText::FromString(FString::Printf(TEXT("%d thumbnails could not be saved"), Failed)));
+	}
+	return Failed;
+}
+
+int32 FThumbnailPackageSaver::ReleaseUnloadCandidates()
+{
+	//A released package may be loaded again, which must not read a half written file
+	FinishWrites();
+
+	UAssetEditorSubsystem* AssetEditors = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+
+	int32 NumReleased = 0;
+	for (const TWeakObjectPtr<UPackage>& Candidate : UnloadCandidates)
+	{
+		UPackage* Package = Candidate.Get();
+		if (!Package || Package->IsDirty())
+		{
+			continue;
+		}
+
+		//Anything still referenced, like the asset shown in a slot, simply survives the collection
+		bool bOpenInEditor = false;
+		ForEachObjectWithPackage(Package, [AssetEditors, &bOpenInEditor](UObject* Object)
+		{
+			bOpenInEditor |= AssetEditors && AssetEditors->FindEditorForAsset(Object, false) != nullptr;
+			return !bOpenInEditor;
+		}, false);
+		if (bOpenInEditor)
+		{
+			continue;
+		}
+
+		ForEachObjectWithPackage(Package, [](UObject* Object)
+		{
+			Object->ClearFlags(RF_Standalone);
+			return true;
+		}, false);
+		++NumReleased;
+	}
+	UnloadCandidates.Reset();
+
+	return NumReleased;
+}
@@ -0,0 +1,1118 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailPipeline.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Client/ThumbnailViewportClient.h"
+#include "Objects/ThumbnailOptions.h"
+#include "Slate/SThumbnailViewport.h"
+#include "Pipeline/ThumbnailImporter.h"
+#include "Pipeline/ThumbnailResampler.h"
+#include "Pipeline/ThumbnailViewportCaptureBackend.h"
+#include "Pipeline/ThumbnailScenePoolCaptureBackend.h"
+#include "Pipeline/ThumbnailSyntheticCaptureBackend.h"
+
+//Image
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Misc/App.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectGlobals.h"
+
+//Max captured images waiting for a worker, the in flight window keeps it below this
+static const int32 StageQueueCapacity = 64;
+
+DECLARE_CYCLE_STAT(TEXT("Pump"), STAT_ThumbnailPump, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Assign Asset"), STAT_ThumbnailAssign, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Readiness Wait"), STAT_ThumbnailReadiness, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Render"), STAT_ThumbnailRender, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Readback Poll"), STAT_ThumbnailReadbackPoll, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Decode"), STAT_ThumbnailDecode, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Encode"), STAT_ThumbnailEncode, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Downsample"), STAT_ThumbnailDownsample, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Auto Crop"), STAT_ThumbnailAutoCrop, STATGROUP_ThumbnailCreator);
+DECLARE_CYCLE_STAT(TEXT("Import"), STAT_ThumbnailImport, STATGROUP_ThumbnailCreator);
+
+//Accumulators keep their value on frames without a pump
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Assets Loading"), STAT_ThumbnailAssetsLoading, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Assign Depth"), STAT_ThumbnailAssignDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ready Depth"), STAT_ThumbnailReadyDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Capture Depth"), STAT_ThumbnailCaptureDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Readback Depth"), STAT_ThumbnailReadbackDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decode Depth"), STAT_ThumbnailDecodeDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import Depth"), STAT_ThumbnailImportDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Depth"), STAT_ThumbnailSaveDepth, STATGROUP_ThumbnailCreator);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Images In Flight"), STAT_ThumbnailImagesInFlight, STATGROUP_ThumbnailCreator);
+
+FThumbnailPipeline::FThumbnailPipeline(FThumbnailCreatorModule& InModule)
+	: Module(InModule)
+	, CapturedImages(StageQueueCapacity)
+{
+	//Load on the game thread, workers only look the module up
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	//New pngs are reported by the watcher, images already in the folder are never listed
+	WatchedPath = FPaths::ConvertRelativePathToFull(Module.Path);
+	IFileManager::Get().MakeDirectory(*WatchedPath, true);
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+	{
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(WatchedPath, IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FThumbnailPipeline::OnDirectoryChanged), DirectoryWatcherHandle);
+	}
+
+	ViewportBackend = MakeUnique<FThumbnailViewportCaptureBackend>(Module);
+	ViewportBackend->OnCaptured.BindRaw(this, &FThumbnailPipeline::OnCaptureReadback, (IThumbnailCaptureBackend*)ViewportBackend.Get());
+
+	//The scene pool is only created once assets are queued
+	LayoutSlots();
+}
+
+FThumbnailPipeline::~FThumbnailPipeline()
+{
+	if (PumpHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PumpHandle);
+	}
+
+	//Let the preview go back to on demand redraws
+	if (bViewportRealtime && Module.ViewportPtr.IsValid() && Module.ViewportPtr->GetViewportClient().IsValid())
+	{
+		Module.ViewportPtr->GetViewportClient()->SetPipelineBusy(false);
+	}
+
+	//No more change notifications into a dead pipeline
+	if (DirectoryWatcherHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+		{
+			if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedPath, DirectoryWatcherHandle);
+			}
+		}
+	}
+
+	//Workers write into our queues, they have to be done before we go away
+	UE::Tasks::Wait(WorkerTasks);
+}
+
+void FThumbnailPipeline::EnqueueAssets(const TArray<FAssetData>& Assets)
+{
+	BeginBatch();
+
+	QueueAssets(Assets);
+	Kick();
+}
+
+void FThumbnailPipeline::BeginBatch()
+{
+	if (!IsIdle())
+	{
+		return;
+	}
+
+	Saver.SetTrackUnloads(Module.ThumbnailOptions && Module.ThumbnailOptions->MemoryHighWaterMB > 0);
+
+	BatchStartTime = FPlatformTime::Seconds();
+	BatchImported = 0;
+	BatchSkipped = 0;
+	OnBatchStarted.Broadcast();
+}
+
+void FThumbnailPipeline::QueueAssets(const TArray<FAssetData>& Assets)
+{
+	const bool bSkipUnchanged = Module.ThumbnailOptions && Module.ThumbnailOptions->bSkipUnchanged;
+	const uint64 OptionsHash = bSkipUnchanged ? GetOptionsHash() : 0;
+
+	//Unsupported types are dropped here, before anything is loaded
+	for (const FAssetData& Asset : Assets)
+	{
+		if (bSkipUnchanged && Cache.IsUpToDate(Asset, FThumbnailCache::MakeKey(Asset, OptionsHash), *Module.ThumbnailOptions))
+		{
+			++BatchSkipped;
+			++Stats.Skipped;
+			continue;
+		}
+
+		if (Prefetcher.Enqueue(Asset))
+		{
+			++Stats.Queued;
+		}
+		else
+		{
+			++Stats.Unsupported;
+		}
+	}
+}
+
+void FThumbnailPipeline::EnqueueQuery(const FARFilter& Filter)
+{
+	BeginBatch();
+
+	Queries.Add(MakeUnique<FThumbnailAssetQuery>(Filter));
+	Kick();
+}
+
+void FThumbnailPipeline::EnqueueCurrentView()
+{
+	BeginBatch();
+	++NumPendingViewShots;
+	Kick();
+}
+
+void FThumbnailPipeline::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+	bool bAnyNew = false;
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (Change.Action == FFileChangeData::FCA_Removed || !FPaths::GetExtension(Change.Filename).Equals(TEXT("png"), ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+
+		//Our own exports and images that were already imported
+		FString Full = FPaths::ConvertRelativePathToFull(Change.Filename);
+		if (KnownImages.Contains(Full))
+		{
+			continue;
+		}
+
+		if (!bAnyNew)
+		{
+			BeginBatch();
+		}
+		NewImages.Add(MoveTemp(Full), FPlatformTime::Seconds());
+		bAnyNew = true;
+	}
+
+	if (bAnyNew)
+	{
+		Kick();
+	}
+}
+
+void FThumbnailPipeline::OnCaptureReadback(int32 Slot, FThumbnailImage& Image, IThumbnailCaptureBackend* Backend)
+{
+	for (FThumbnailCaptureSlot& CaptureSlot : Slots)
+	{
+		if (CaptureSlot.Backend != Backend || CaptureSlot.Index != Slot)
+		{
+			continue;
+		}
+
+		//Captures of a slot come back in the order they were taken
+		if (CaptureSlot.Captured.Num() > 0)
+		{
+			Image.SourceAsset = MoveTemp(CaptureSlot.Captured[0].AssetPath);
+			Image.CacheKey = CaptureSlot.Captured[0].CacheKey;
+			Image.Timings = CaptureSlot.Captured[0].Timings;
+			Image.Timings.EndStage(Image.Timings.Capture);
+			CaptureSlot.Captured.RemoveAt(0);
+		}
+
+		//Pipelined backends freed the slot when the capture was queued
+		if (!Backend->IsPipelined())
+		{
+			CaptureSlot.bBusy = false;
+		}
+	}
+
+	//The capture stage only requests a shot when the in flight window has room for it
+	if (Image.Pixels.Num() > 0)
+	{
+		if (Module.ThumbnailOptions && !Module.ThumbnailOptions->bCaptureToMemory)
+		{
+			Image.ExportFile = Module.Path + Image.AssetName + ".png";
+		}
+		if (!ensureMsgf(CapturedImages.Push(MoveTemp(Image)), TEXT("Captured image queue is smaller than the in flight window")))
+		{
+			--NumImagesInFlight;
+			++Stats.Failed;
+		}
+	}
+	else
+	{
+		--NumImagesInFlight;
+		++Stats.Failed;
+	}
+	Kick();
+}
+
+void FThumbnailPipeline::Cancel()
+{
+	//A shot already requested still reports back, only assets waiting on readiness can be dropped
+	for (FThumbnailCaptureSlot& Slot : Slots)
+	{
+		if (Slot.bAssigned)
+		{
+			Slot.Readiness.Reset();
+			Slot.bAssigned = false;
+			Slot.bBusy = false;
+			--NumImagesInFlight;
+		}
+	}
+
+	Prefetcher.Empty();
+	Queries.Empty();
+	NumPendingViewShots = 0;
+
+	NumImagesInFlight -= CapturedImages.Num();
+	CapturedImages.Empty();
+
+	//Dropped pngs stay on disk but are not imported anymore
+	for (const TPair<FString, double>& Pending : NewImages)
+	{
+		KnownImages.Add(Pending.Key);
+	}
+	NewImages.Empty();
+}
+
+void FThumbnailPipeline::SetViewportAvailable(bool bAvailable)
+{
+	ViewportBackend->SetAvailable(bAvailable);
+	//A fresh client starts out of realtime, tell it again on the next pump
+	bViewportRealtime = false;
+	if (bAvailable)
+	{
+		return;
+	}
+
+	//Assigned assets and requested shots of the viewport never report back
+	for (FThumbnailCaptureSlot& Slot : Slots)
+	{
+		if (Slot.Backend != ViewportBackend.Get())
+		{
+			continue;
+		}
+
+		const int32 NumLost = (Slot.bAssigned ? 1 : 0) + Slot.Captured.Num();
+		NumImagesInFlight -= NumLost;
+		Stats.Failed += NumLost;
+
+		Slot.Readiness.Reset();
+		Slot.Assigned = FThumbnailCaptureSource();
+		Slot.Captured.Reset();
+		Slot.bAssigned = false;
+		Slot.bBusy = false;
+	}
+
+	Stats.Failed += NumPendingViewShots;
+	NumPendingViewShots = 0;
+	if (AssetBackend == ViewportBackend.Get())
+	{
+		Prefetcher.Empty();
+	}
+	Kick();
+}
+
+bool FThumbnailPipeline::IsIdle() const
+{
+	return Prefetcher.Num() == 0 && Queries.Num() == 0 && NumPendingViewShots == 0 && NumImagesInFlight == 0 && NumWorkerImages == 0 && NewImages.Num() == 0;
+}
+
+bool FThumbnailPipeline::IsViewportBusy() const
+{
+	if (NumPendingViewShots > 0)
+	{
+		return true;
+	}
+	for (const FThumbnailCaptureSlot& Slot : Slots)
+	{
+		if (Slot.Backend == ViewportBackend.Get() && Slot.bBusy)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FThumbnailPipeline::GetNumFoldersLeft() const
+{
+	int32 NumFolders = 0;
+	for (const TUniquePtr<FThumbnailAssetQuery>& Query : Queries)
+	{
+		NumFolders += Query->GetNumFoldersLeft();
+	}
+	return NumFolders;
+}
+
+int32 FThumbnailPipeline::GetStageDepth(EThumbnailStage Stage) const
+{
+	int32 Depth = 0;
+	switch (Stage)
+	{
+	case EThumbnailStage::Assign:
+		return Prefetcher.Num() + NumPendingViewShots;
+	case EThumbnailStage::Ready:
+		for (const FThumbnailCaptureSlot& Slot : Slots)
+		{
+			Depth += Slot.bAssigned ? 1 : 0;
+		}
+		return Depth;
+	case EThumbnailStage::Capture:
+		for (const FThumbnailCaptureSlot& Slot : Slots)
+		{
+			Depth += Slot.bBusy && !Slot.bAssigned ? 1 : 0;
+		}
+		return Depth;
+	case EThumbnailStage::Readback:
+		return NewImages.Num() + (OffscreenBackend.IsValid() ? OffscreenBackend->GetNumPendingReadbacks() : 0);
+	case EThumbnailStage::Decode:
+		return CapturedImages.Num();
+	case EThumbnailStage::Import:
+		return NumWorkerImages;
+	case EThumbnailStage::Save:
+		return Saver.Num();
+	default:
+		return 0;
+	}
+}
+
+void FThumbnailPipeline::Kick()
+{
+	if (PumpHandle.IsValid())
+	{
+		return;
+	}
+	PumpHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FThumbnailPipeline::Pump), 0.0f);
+}
+
+bool FThumbnailPipeline::Pump(float Delta)
+{
+	THUMBNAIL_SCOPE(STAT_ThumbnailPump);
+	PumpHandle.Reset();
+
+	WorkerTasks.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+	//Every round moves at most one item per stage, so cheap items fit many rounds into the budget
+	const double BudgetSeconds = GetFrameBudgetSeconds();
+	const double PumpStart = FPlatformTime::Seconds();
+
+	//Drain from the back so finished work makes room for the stages in front of it
+	bool bProgress = true;
+	while (bProgress)
+	{
+		if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - PumpStart >= BudgetSeconds)
+		{
+			//Out of time for this frame, the rest runs on the next one
+			Kick();
+			break;
+		}
+
+		bProgress = false;
+		bProgress |= RunPackageSaveStage();
+		bProgress |= RunImportStage();
+		bProgress |= RunDecodeStage();
+		bProgress |= RunReadbackStage();
+		bProgress |= RunCaptureStage();
+	}
+
+	if (!IsIdle())
+	{
+		UpdateMemory();
+	}
+	UpdateStatCounters();
+	UpdateViewportRealtime();
+
+	if (IsIdle() && (BatchImported > 0 || BatchSkipped > 0))
+	{
+		const double Seconds = FPlatformTime::Seconds() - BatchStartTime;
+		UE_LOG(LogThumbnailCreator, Log, TEXT("Generated %d thumbnails in %.2fs (%.1f/s) with %d capture slots, skipped %d up to date, peak memory %llu MB"), BatchImported, Seconds, BatchImported / FMath::Max(Seconds, 0.001), AssetBackend ? AssetBackend->GetNumSlots() : 0, BatchSkipped, Stats.PeakUsedPhysical / (1024 * 1024));
+		BatchImported = 0;
+		BatchSkipped = 0;
+	}
+
+	if (IsIdle())
+	{
+		ReleaseIdleResources();
+		OnIdle.Broadcast();
+	}
+
+	//Nothing left that is runnable, the next completion event schedules a new pump
+	return false;
+}
+
+void FThumbnailPipeline::UpdateViewportRealtime()
+{
+	const bool bBusy = IsViewportBusy();
+	if (bBusy == bViewportRealtime)
+	{
+		return;
+	}
+
+	bViewportRealtime = bBusy;
+	if (Module.ViewportPtr.IsValid() && Module.ViewportPtr->GetViewportClient().IsValid())
+	{
+		Module.ViewportPtr->GetViewportClient()->SetPipelineBusy(bBusy);
+	}
+}
+
+void FThumbnailPipeline::UpdateStatCounters() const
+{
+	SET_DWORD_STAT(STAT_ThumbnailAssetsLoading, Prefetcher.NumLoading());
+	SET_DWORD_STAT(STAT_ThumbnailAssignDepth, GetStageDepth(EThumbnailStage::Assign));
+	SET_DWORD_STAT(STAT_ThumbnailReadyDepth, GetStageDepth(EThumbnailStage::Ready));
+	SET_DWORD_STAT(STAT_ThumbnailCaptureDepth, GetStageDepth(EThumbnailStage::Capture));
+	SET_DWORD_STAT(STAT_ThumbnailReadbackDepth, GetStageDepth(EThumbnailStage::Readback));
+	SET_DWORD_STAT(STAT_ThumbnailDecodeDepth, GetStageDepth(EThumbnailStage::Decode));
+	SET_DWORD_STAT(STAT_ThumbnailImportDepth, GetStageDepth(EThumbnailStage::Import));
+	SET_DWORD_STAT(STAT_ThumbnailSaveDepth, GetStageDepth(EThumbnailStage::Save));
+	SET_DWORD_STAT(STAT_ThumbnailImagesInFlight, NumImagesInFlight);
+}
+
+int32 FThumbnailPipeline::GetMaxImagesInFlight() const
+{
+	return Module.ThumbnailOptions ? FMath::Clamp(Module.ThumbnailOptions->MaxImagesInFlight, 1, StageQueueCapacity) : 1;
+}
+
+int32 FThumbnailPipeline::GetPrefetchCount() const
+{
+	return Module.ThumbnailOptions ? FMath::Max(1, Module.ThumbnailOptions->PrefetchCount) : 1;
+}
+
+double FThumbnailPipeline::GetFrameBudgetSeconds() const
+{
+	//Nobody is waiting on the editor in batch runs
+	if (IsRunningCommandlet() || FApp::IsUnattended())
+	{
+		return 0.0;
+	}
+	return Module.ThumbnailOptions ? FMath::Max(0.f, Module.ThumbnailOptions->FrameBudgetMs) / 1000.0 : 0.0;
+}
+
+int32 FThumbnailPipeline::GetProfileIndex() const
+{
+	return Module.ViewportPtr.IsValid() ? Module.ViewportPtr->PreviewScene->GetCurrentProfileIndex() : 0;
+}
+
+uint64 FThumbnailPipeline::GetOptionsHash() const
+{
+	if (!Module.ThumbnailOptions)
+	{
+		return 0;
+	}
+
+	const TOptional<FThumbnailCaptureView> ManualView = GetManualView();
+	return FThumbnailCache::HashOptions(*Module.ThumbnailOptions, GetProfileIndex(), ManualView.GetPtrOrNull());
+}
+
+TOptional<FThumbnailCaptureView> FThumbnailPipeline::GetManualView() const
+{
+	if (!Module.ThumbnailOptions || Module.ThumbnailOptions->bUseAutoSize || !Module.ViewportPtr.IsValid() || !Module.ViewportPtr->GetViewportClient().IsValid())
+	{
+		return TOptional<FThumbnailCaptureView>();
+	}
+
+	const TSharedPtr<FThumbnailViewportClient> Client = Module.ViewportPtr->GetViewportClient();
+	FThumbnailCaptureView View;
+	View.Location = Client->GetViewLocation();
+	View.Rotation = Client->GetViewRotation();
+	View.FOV = Client->ViewFOV;
+	return View;
+}
+
+bool FThumbnailPipeline::CanStartCapture() const
+{
+	return !CapturedImages.IsFull() && NumImagesInFlight < GetMaxImagesInFlight();
+}
+
+void FThumbnailPipeline::UpdateBackends()
+{
+	for (const FThumbnailCaptureSlot& Slot : Slots)
+	{
+		if (Slot.bBusy)
+		{
+			return;
+		}
+	}
+
+	//Recreating the pool would lose the images still being read back
+	if (OffscreenBackend.IsValid() && OffscreenBackend->GetNumPendingReadbacks() > 0)
+	{
+		return;
+	}
+
+	const UThumbnailOptions* Options = Module.ThumbnailOptions;
+	const EThumbnailCaptureBackend Type = Options ? Options->CaptureBackend : EThumbnailCaptureBackend::Viewport;
+	const int32 NumScenes = Options ? FMath::Clamp(Options->CaptureSceneCount, 1, 8) : 1;
+
+	if (Type == EThumbnailCaptureBackend::Viewport)
+	{
+		OffscreenBackend.Reset();
+	}
+	else if (!OffscreenBackend.IsValid() || OffscreenBackendType != Type || OffscreenBackend->GetNumSlots() != NumScenes)
+	{
+		if (Type == EThumbnailCaptureBackend::Synthetic)
+		{
+			OffscreenBackend = MakeUnique<FThumbnailSyntheticCaptureBackend>(NumScenes);
+		}
+		else
+		{
+			//Light the offscreen scenes with the profile picked in the tab
+			OffscreenBackend = MakeUnique<FThumbnailScenePoolCaptureBackend>(NumScenes, GetProfileIndex());
+		}
+		OffscreenBackendType = Type;
+		OffscreenBackend->OnCaptured.BindRaw(this, &FThumbnailPipeline::OnCaptureReadback, OffscreenBackend.Get());
+	}
+
+	LayoutSlots();
+}
+
+void FThumbnailPipeline::LayoutSlots()
+{
+	AssetBackend = OffscreenBackend.IsValid() ? OffscreenBackend.Get() : (IThumbnailCaptureBackend*)ViewportBackend.Get();
+
+	//Viewport slot always exists for current view shots
+	Slots.Reset();
+	for (IThumbnailCaptureBackend* Backend : { (IThumbnailCaptureBackend*)ViewportBackend.Get(), OffscreenBackend.Get() })
+	{
+		for (int32 Index = 0; Backend && Index < Backend->GetNumSlots(); ++Index)
+		{
+			FThumbnailCaptureSlot& Slot = Slots.AddDefaulted_GetRef();
+			Slot.Backend = Backend;
+			Slot.Index = Index;
+		}
+	}
+}
+
+void FThumbnailPipeline::ReleaseIdleResources()
+{
+	//Last group of the batch, and make sure it is on disk before anyone copies the content folder
+	SavePendingPackages();
+	Saver.FinishWrites();
+	Stats.Failed += Saver.TakeNumFailed();
+	Cache.Flush();
+
+	if (OffscreenBackend.IsValid())
+	{
+		OffscreenBackend.Reset();
+		LayoutSlots();
+	}
+}
+
+bool FThumbnailPipeline::RefillFromQueries()
+{
+	//Enough to keep loads and slots busy until the next pump, the rest stays in the registry
+	const int32 LowWater = GetPrefetchCount() + Slots.Num();
+	if (Queries.Num() == 0 || Prefetcher.Num() >= LowWater)
+	{
+		return false;
+	}
+
+	//A page per round, so a run of skipped folders still respects the frame budget, the queue only refills once it runs low again
+	TArray<FAssetData> Page;
+	if (Queries[0]->NextPage(Page))
+	{
+		QueueAssets(Page);
+	}
+	else
+	{
+		Queries.RemoveAt(0);
+	}
+	return true;
+}
+
+bool FThumbnailPipeline::RunCaptureStage()
+{
+	bool bProgress = RefillFromQueries();
+
+	//Options may have switched backend since the last batch
+	if (Prefetcher.Num() > 0)
+	{
+		UpdateBackends();
+	}
+
+	//Keep loads running ahead of the capture, finished loads schedule a pump
+	Prefetcher.Update(GetPrefetchCount(), FSimpleDelegate::CreateSP(this, &FThumbnailPipeline::Kick));
+
+	//Without the tab there is no viewport to capture with
+	if (!ViewportBackend->IsAvailable())
+	{
+		NumPendingViewShots = 0;
+		if (AssetBackend == ViewportBackend.Get())
+		{
+			Prefetcher.Empty();
+		}
+	}
+
+	//Collect readbacks queued on earlier frames, keep polling while the gpu still has some
+	for (IThumbnailCaptureBackend* Backend : { (IThumbnailCaptureBackend*)ViewportBackend.Get(), OffscreenBackend.Get() })
+	{
+		if (Backend)
+		{
+			THUMBNAIL_SCOPE(STAT_ThumbnailReadbackPoll);
+			bProgress |= Backend->PollReadbacks();
+			if (Backend->GetNumPendingReadbacks() > 0)
+			{
+				Kick();
+			}
+		}
+	}
+
+	//Dispatch over every slot, each one holds its own asset
+	for (FThumbnailCaptureSlot& Slot : Slots)
+	{
+		bProgress |= RunCaptureSlot(Slot);
+	}
+	return bProgress;
+}
+
+bool FThumbnailPipeline::RunCaptureSlot(FThumbnailCaptureSlot& Slot)
+{
+	//Assigned asset is waiting to be ready, the shot is requested once it is
+	if (Slot.bAssigned)
+	{
+		//Tab was closed while waiting
+		if (!Slot.Backend->IsAvailable())
+		{
+			Slot.Readiness.Reset();
+			Slot.bAssigned = false;
+			Slot.bBusy = false;
+			--NumImagesInFlight;
+			return true;
+		}
+
+		//Too many readbacks on their way back already, the next poll frees one
+		if (!Slot.Backend->CanBeginCapture(*Module.ThumbnailOptions))
+		{
+			Kick();
+			return false;
+		}
+
+		bool bTimedOut = false;
+		bool bReady = false;
+		{
+			THUMBNAIL_SCOPE(STAT_ThumbnailReadiness);
+			bReady = Slot.Readiness.Poll(bTimedOut);
+		}
+		if (!bReady)
+		{
+			//Nothing reports readiness, check again next frame
+			Kick();
+			return false;
+		}
+
+		if (bTimedOut)
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("Capturing slot %d before its asset finished compiling or streaming"), Slot.Index);
+		}
+
+		//Result comes back through OnCaptureReadback, pipelined backends take the next asset right away
+		Slot.Assigned.Timings.EndStage(Slot.Assigned.Timings.Ready);
+		Slot.bAssigned = false;
+		Slot.Captured.Add(MoveTemp(Slot.Assigned));
+		Slot.Assigned = FThumbnailCaptureSource();
+		{
+			THUMBNAIL_SCOPE(STAT_ThumbnailRender);
+			Slot.Backend->SetManualView(GetManualView());
+			Slot.Backend->Capture(Slot.Index, *Module.ThumbnailOptions);
+		}
+		if (Slot.Backend->IsPipelined())
+		{
+			Slot.bBusy = false;
+		}
+		return true;
+	}
+
+	//Only while the in flight window has room for the result
+	if (Slot.bBusy || !CanStartCapture() || !Slot.Backend->IsAvailable())
+	{
+		return false;
+	}
+
+	//Current view shots go through the viewport as it is
+	if (Slot.Backend == ViewportBackend.Get() && NumPendingViewShots > 0)
+	{
+		--NumPendingViewShots;
+		Slot.bBusy = true;
+		++NumImagesInFlight;
+		Slot.Captured.AddDefaulted_GetRef().Timings.StageStart = FPlatformTime::Seconds();
+		THUMBNAIL_SCOPE(STAT_ThumbnailRender);
+		Slot.Backend->Capture(Slot.Index, *Module.ThumbnailOptions);
+		return true;
+	}
+
+	if (Slot.Backend != AssetBackend)
+	{
+		return false;
+	}
+
+	//Next asset is still loading, its load completion schedules the next pump
+	FThumbnailPrefetchedAsset Asset;
+	if (!Prefetcher.PopLoaded(Asset))
+	{
+		return false;
+	}
+
+	//Assets that failed to load don't take a shot, nothing will report back for them
+	bool bAssigned = false;
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailAssign);
+		bAssigned = Slot.Backend->AssignAsset(Slot.Index, Asset.GetAsset(), Asset.Type, *Module.ThumbnailOptions);
+	}
+	if (bAssigned)
+	{
+		Slot.bBusy = true;
+		Slot.bAssigned = true;
+		++NumImagesInFlight;
+
+		//Sources only we loaded can be released again once memory runs high
+		if (!Asset.bWasLoaded)
+		{
+			Saver.AddUnloadCandidate(Asset.GetAsset()->GetPackage());
+		}
+
+		Slot.Assigned.AssetPath = Asset.Data.GetObjectPathString();
+		Slot.Assigned.CacheKey = FThumbnailCache::MakeKey(Asset.Data, GetOptionsHash());
+		Slot.Assigned.Timings.Begin = Asset.RequestTime;
+		Slot.Assigned.Timings.StageStart = Asset.RequestTime;
+		Slot.Assigned.Timings.EndStage(Slot.Assigned.Timings.Load);
+
+		const int32 TargetResolution = FMath::Max(Module.ThumbnailOptions->ScreenshotXSize, Module.ThumbnailOptions->ScreenshotYSize) * FMath::Max(1, Module.ThumbnailOptions->GetCaptureProfile().Supersample);
+		Slot.Readiness.Begin(Slot.Backend->GetActiveComponent(Slot.Index), TargetResolution, Module.ThumbnailOptions->ReadinessTimeout);
+	}
+	else
+	{
+		++Stats.Failed;
+	}
+
+	return true;
+}
+
+bool FThumbnailPipeline::RunReadbackStage()
+{
+	if (NewImages.Num() == 0)
+	{
+		return false;
+	}
+
+	//Writers may still be busy with a png right after it shows up
+	static const double SettleSeconds = 0.25;
+	const double Now = FPlatformTime::Seconds();
+
+	bool bProgress = false;
+	for (auto It = NewImages.CreateIterator(); It; ++It)
+	{
+		//In flight window or decode stage is full, the next pump takes the rest
+		if (CapturedImages.IsFull() || NumImagesInFlight >= GetMaxImagesInFlight())
+		{
+			break;
+		}
+
+		if (Now - It.Value() < SettleSeconds)
+		{
+			continue;
+		}
+
+		//Never import the same file twice
+		KnownImages.Add(It.Key());
+
+		FThumbnailImage Written;
+		Written.AssetName = FPaths::GetBaseFilename(It.Key());
+		Written.SourceFile = It.Key();
+		Written.Timings.StageStart = Now;
+		if (ensure(CapturedImages.Push(MoveTemp(Written))))
+		{
+			++NumImagesInFlight;
+		}
+		else
+		{
+			++Stats.Failed;
+		}
+
+		It.RemoveCurrent();
+		bProgress = true;
+	}
+
+	//Unsettled files are checked again next frame
+	if (NewImages.Num() > 0 && !CapturedImages.IsFull() && NumImagesInFlight < GetMaxImagesInFlight())
+	{
+		Kick();
+	}
+
+	return bProgress;
+}
+
+bool FThumbnailPipeline::RunDecodeStage()
+{
+	FThumbnailImage Image;
+	if (!CapturedImages.Pop(Image))
+	{
+		return false;
+	}
+
+	//Our own export must not be picked up again by the directory watcher
+	if (!Image.ExportFile.IsEmpty())
+	{
+		KnownImages.Add(FPaths::ConvertRelativePathToFull(Image.ExportFile));
+	}
+
+	++NumWorkerImages;
+
+	//Options are only read on the game thread
+	FThumbnailProcessSettings Settings;
+	if (const UThumbnailOptions* Options = Module.ThumbnailOptions)
+	{
+		Settings.OutputSizes = Options->ExtraOutputSizes;
+		Settings.bAutoCrop = Options->bAutoCrop;
+		Settings.AutoCropPadding = Options->AutoCropPadding;
+		Settings.AutoCropAlphaThreshold = (uint8)FMath::Clamp(Options->AutoCropAlphaThreshold, 0, 254);
+	}
+
+	TWeakPtr<FThumbnailPipeline> WeakThis = AsShared();
+	WorkerTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, WeakThis, Image = MoveTemp(Image), Settings = MoveTemp(Settings)]() mutable
+	{
+		if (!ProcessImage(Image, Settings))
+		{
+			//Keep the name so the import stage can account for it, but without pixels
+			Image.Pixels.Empty();
+		}
+		Image.Timings.EndStage(Image.Timings.Process);
+		ProcessedImages.Enqueue(MoveTemp(Image));
+
+		//Back to the game thread for the UObject side
+		AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+		{
+			if (TSharedPtr<FThumbnailPipeline> Pinned = WeakThis.Pin())
+			{
+				Pinned->Kick();
+			}
+		});
+	}));
+
+	return true;
+}
+
+bool FThumbnailPipeline::ProcessImage(FThumbnailImage& Image, const FThumbnailProcessSettings& Settings)
+{
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	//Images found on disk are decoded once, the importer uses these pixels as the texture source
+	if (Image.Pixels.Num() == 0 && !Image.SourceFile.IsEmpty())
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailDecode);
+
+		TArray64<uint8> Compressed;
+		if (!FFileHelper::LoadFileToArray(Compressed, *Image.SourceFile))
+		{
+			return false;
+		}
+
+		// Note: PNG format.  Other formats are supported
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+
+		TArray64<uint8> UncompressedBGRA;
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()) || !ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
+		{
+			return false;
+		}
+
+		Image.Size = FIntPoint(ImageWrapper->GetWidth(), ImageWrapper->GetHeight());
+		Image.Pixels.SetNumUninitialized(Image.Size.X * Image.Size.Y);
+		FMemory::Memcpy(Image.Pixels.GetData(), UncompressedBGRA.GetData(), UncompressedBGRA.Num());
+	}
+
+	if (Image.Pixels.Num() == 0)
+	{
+		return false;
+	}
+
+	//Cropped at full resolution so the scale up has every supersampled pixel to work with
+	if (Settings.bAutoCrop)
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailAutoCrop);
+		FThumbnailResampler::AutoCrop(Image, Settings.AutoCropPadding, Settings.AutoCropAlphaThreshold);
+	}
+
+	//Supersampled captures are filtered down to the output size
+	if (Image.Supersample > 1)
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailDownsample);
+		if (!FThumbnailResampler::Downsample(Image, Image.Supersample))
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("%s is %dx%d, not a multiple of its supersample factor %d"), *Image.AssetName, Image.Size.X, Image.Size.Y, Image.Supersample);
+		}
+		Image.Supersample = 1;
+	}
+
+	//Smaller sizes come from this image, one render for all of them
+	if (Settings.OutputSizes.Num() > 0)
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailDownsample);
+		FThumbnailResampler::BuildExtraOutputs(Image, Settings.OutputSizes);
+	}
+
+	//Write the png copy of captures that should be kept on disk
+	if (!Image.ExportFile.IsEmpty())
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailEncode);
+
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(Image.Pixels.GetData(), Image.Pixels.Num() * sizeof(FColor), Image.Size.X, Image.Size.Y, ERGBFormat::BGRA, 8))
+		{
+			const TArray64<uint8>& Compressed = ImageWrapper->GetCompressed();
+			if (FFileHelper::SaveArrayToFile(Compressed, *Image.ExportFile))
+			{
+				INC_DWORD_STAT_BY(STAT_ThumbnailBytesWritten, Compressed.Num());
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FThumbnailPipeline::RunImportStage()
+{
+	FThumbnailImage Image;
+	if (!ProcessedImages.Dequeue(Image))
+	{
+		return false;
+	}
+	--NumWorkerImages;
+	--NumImagesInFlight;
+
+	if (Image.Pixels.Num() == 0)
+	{
+		++Stats.Failed;
+		return true;
+	}
+
+	bool bUnchanged = false;
+	if (!ImportImage(Image, bUnchanged))
+	{
+		++Stats.Failed;
+		return true;
+	}
+
+	//Smaller copies share the fate of the main thumbnail, a failed one only counts as failure
+	for (FThumbnailOutput& Output : Image.ExtraOutputs)
+	{
+		FThumbnailImage Extra;
+		Extra.AssetName = MoveTemp(Output.AssetName);
+		Extra.Size = Output.Size;
+		Extra.Pixels = MoveTemp(Output.Pixels);
+
+		bool bExtraUnchanged = false;
+		if (!ImportImage(Extra, bExtraUnchanged))
+		{
+			++Stats.Failed;
+		}
+	}
+	Image.ExtraOutputs.Empty();
+
+	++BatchImported;
+	++Stats.Imported;
+	Stats.Unchanged += bUnchanged ? 1 : 0;
+	Cache.Record(Image.SourceAsset, Image.CacheKey, Image.AssetName);
+
+	Image.Timings.EndStage(Image.Timings.Import);
+	OnImported.Broadcast(Image);
+
+	return true;
+}
+
+bool FThumbnailPipeline::ImportImage(const FThumbnailImage& Image, bool& bOutUnchanged)
+{
+	const bool bWasLoaded = FindPackage(nullptr, *(FString(FThumbnailImporter::ExportPath) + Image.AssetName)) != nullptr;
+	bool bExistingAsset = false;
+	const int32 Tolerance = Module.ThumbnailOptions ? Module.ThumbnailOptions->PixelTolerance : 0;
+	UTexture2D* Texture = nullptr;
+	{
+		THUMBNAIL_SCOPE(STAT_ThumbnailImport);
+		Texture = FThumbnailImporter::ImportTexture(Image, Tolerance, bExistingAsset, bOutUnchanged);
+	}
+	if (!Texture)
+	{
+		return false;
+	}
+
+	//Untouched textures stay clean, nothing to save or check out
+	if (!bOutUnchanged)
+	{
+		RunSaveStage(Texture, Texture->GetPackage(), bExistingAsset, bWasLoaded);
+	}
+	return true;
+}
+
+void FThumbnailPipeline::RunSaveStage(UTexture2D* Texture, UPackage* Package, bool bExistingAsset, bool bWasLoaded)
+{
+	Package->SetDirtyFlag(true);
+
+	//Notify new asset created, existing ones are already known to the registry
+	if (!bExistingAsset)
+	{
+		FAssetRegistryModule::AssetCreated(Texture);
+	}
+
+	const int32 GroupSize = Module.ThumbnailOptions ? Module.ThumbnailOptions->SaveGroupSize : 0;
+	if (GroupSize > 0)
+	{
+		Saver.Add(Package, bWasLoaded);
+
+		//The group is saved over the next rounds, next to the captures that keep running
+		bSavingGroup |= Saver.Num() >= GroupSize;
+	}
+}
+
+bool FThumbnailPipeline::RunPackageSaveStage()
+{
+	if (!bSavingGroup)
+	{
+		return false;
+	}
+	if (Saver.Num() == 0)
+	{
+		bSavingGroup = false;
+		return false;
+	}
+
+	Stats.Saved += Saver.SaveNext() ? 1 : 0;
+	return true;
+}
+
+void FThumbnailPipeline::SavePendingPackages()
+{
+	bSavingGroup = false;
+	if (Saver.Num() > 0)
+	{
+		Stats.Saved += Saver.SaveGroup();
+	}
+}
+
+void FThumbnailPipeline::UpdateMemory()
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Stats.PeakUsedPhysical = FMath::Max<uint64>(Stats.PeakUsedPhysical, MemoryStats.UsedPhysical);
+
+	const int32 HighWaterMB = Module.ThumbnailOptions ? Module.ThumbnailOptions->MemoryHighWaterMB : 0;
+	Saver.SetTrackUnloads(HighWaterMB > 0);
+	if (HighWaterMB <= 0 || MemoryStats.UsedPhysical < (uint64)HighWaterMB * 1024 * 1024)
+	{
+		return;
+	}
+
+	//Collecting again before anything new was imported would free nothing
+	const int32 MinImported = Module.ThumbnailOptions ? FMath::Max(1, Module.ThumbnailOptions->SaveGroupSize) : 1;
+	if (Stats.Imported - ImportedAtLastCollection < MinImported)
+	{
+		return;
+	}
+	ImportedAtLastCollection = Stats.Imported;
+
+	//Only saved packages can be released, dirty ones stay until they are saved
+	SavePendingPackages();
+	const int32 NumReleased = Saver.ReleaseUnloadCandidates();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	++Stats.Collections;
+
+	UE_LOG(LogThumbnailCreator, Log, TEXT("Memory at %llu MB is over the %d MB high water mark, released %d packages and collected garbage, now at %llu MB"),
+		MemoryStats.UsedPhysical / (1024 * 1024), HighWaterMB, NumReleased, FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024));
+}
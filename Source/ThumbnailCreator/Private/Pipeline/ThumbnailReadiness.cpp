@@ -0,0 +1,164 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailReadiness.h"
+
+//Engine
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "MaterialShared.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "StaticMeshResources.h"
+
+void FThumbnailReadiness::Begin(UPrimitiveComponent* InComponent, int32 InTargetResolution, double TimeoutSeconds)
+{
+	Reset();
+
+	Component = InComponent;
+	TargetResolution = InTargetResolution;
+	TimeoutTime = FPlatformTime::Seconds() + TimeoutSeconds;
+
+	if (!InComponent)
+	{
+		return;
+	}
+
+	TArray<UMaterialInterface*> UsedMaterials;
+	InComponent->GetUsedMaterials(UsedMaterials);
+
+	const ERHIFeatureLevel::Type FeatureLevel = InComponent->GetWorld() ? InComponent->GetWorld()->GetFeatureLevel() : GMaxRHIFeatureLevel;
+
+	for (UMaterialInterface* Material : UsedMaterials)
+	{
+		if (!Material)
+		{
+			continue;
+		}
+		Materials.Add(Material);
+
+		TArray<UTexture*> UsedTextures;
+		Material->GetUsedTextures(UsedTextures, EMaterialQualityLevel::Num, true, FeatureLevel, true);
+		for (UTexture* Texture : UsedTextures)
+		{
+			UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
+			if (!Texture2D)
+			{
+				continue;
+			}
+
+			//Keep every mip loaded for as long as we may wait, streaming picks the ones it needs from there
+			Texture2D->SetForceMipLevelsToBeResident(TimeoutSeconds);
+			Textures.AddUnique(Texture2D);
+		}
+	}
+}
+
+bool FThumbnailReadiness::Poll(bool& bOutTimedOut)
+{
+	bOutTimedOut = false;
+
+	if (!Component.IsValid())
+	{
+		return true;
+	}
+
+	if (IsMeshReady() && AreMaterialsReady() && AreTexturesReady())
+	{
+		Reset();
+		return true;
+	}
+
+	if (FPlatformTime::Seconds() >= TimeoutTime)
+	{
+		bOutTimedOut = true;
+		Reset();
+		return true;
+	}
+
+	return false;
+}
+
+void FThumbnailReadiness::Reset()
+{
+	Component.Reset();
+	Materials.Reset();
+	Textures.Reset();
+}
+
+bool FThumbnailReadiness::IsMeshReady() const
+{
+	if (const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component.Get()))
+	{
+		const UStaticMesh* Mesh = MeshComp->GetStaticMesh();
+		return !Mesh || (!Mesh->IsCompiling() && Mesh->GetRenderData() && Mesh->GetRenderData()->IsInitialized());
+	}
+
+	if (const USkeletalMeshComponent* SkelMeshComp = Cast<USkeletalMeshComponent>(Component.Get()))
+	{
+		const USkeletalMesh* Mesh = Cast<USkeletalMesh>(SkelMeshComp->GetSkinnedAsset());
+		return !Mesh || (!Mesh->IsCompiling() && Mesh->GetResourceForRendering() && Mesh->GetResourceForRendering()->IsInitialized());
+	}
+
+	return true;
+}
+
+bool FThumbnailReadiness::AreMaterialsReady() const
+{
+	const UWorld* World = Component.IsValid() ? Component->GetWorld() : nullptr;
+	const ERHIFeatureLevel::Type FeatureLevel = World ? World->GetFeatureLevel() : GMaxRHIFeatureLevel;
+
+	for (const TWeakObjectPtr<UMaterialInterface>& Material : Materials)
+	{
+		if (!Material.IsValid())
+		{
+			continue;
+		}
+
+		if (Material->IsCompiling())
+		{
+			return false;
+		}
+
+		//Shader map has to be complete, otherwise the default material is rendered in its place
+		const FMaterialResource* Resource = Material->GetMaterialResource(FeatureLevel);
+		if (Resource && !Resource->IsCompilationFinished())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FThumbnailReadiness::AreTexturesReady() const
+{
+	for (const TWeakObjectPtr<UTexture2D>& Texture : Textures)
+	{
+		if (!Texture.IsValid())
+		{
+			continue;
+		}
+
+		if (Texture->IsCompiling())
+		{
+			return false;
+		}
+
+		//Mips at or above the output size are what the capture can sample, smaller ones don't matter
+		const int32 NumMips = Texture->GetNumMips();
+		const int32 LargestSide = FMath::Max(Texture->GetSizeX(), Texture->GetSizeY());
+		const int32 SkippedMips = TargetResolution > 0 && LargestSide > TargetResolution ? FMath::FloorLog2(LargestSide / TargetResolution) : 0;
+		const int32 RequiredMips = FMath::Max(1, NumMips - SkippedMips);
+
+		if (Texture->GetNumResidentMips() < RequiredMips)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
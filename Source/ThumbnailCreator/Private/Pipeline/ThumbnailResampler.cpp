@@ -0,0 +1,278 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailResampler.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Pipeline/ThumbnailImage.h"
+
+bool FThumbnailResampler::Downsample(FThumbnailImage& Image, int32 Factor)
+{
+	if (Factor <= 1)
+	{
+		return true;
+	}
+	if (Image.Size.X % Factor != 0 || Image.Size.Y % Factor != 0 || Image.Pixels.Num() != Image.Size.X * Image.Size.Y)
+	{
+		return false;
+	}
+
+	const FIntPoint DestSize(Image.Size.X / Factor, Image.Size.Y / Factor);
+	TArray<FColor> Dest;
+	Dest.SetNumUninitialized(DestSize.X * DestSize.Y);
+	BoxReduce(Image.Pixels.GetData(), Image.Size, Factor, Dest.GetData());
+
+	Image.Pixels = MoveTemp(Dest);
+	Image.Size = DestSize;
+	return true;
+}
+
+void FThumbnailResampler::BuildExtraOutputs(FThumbnailImage& Image, const TArray<int32>& Sizes)
+{
+	const int32 Largest = FMath::Max(Image.Size.X, Image.Size.Y);
+	if (Largest <= 0 || Image.Pixels.Num() != Image.Size.X * Image.Size.Y)
+	{
+		return;
+	}
+
+	//Largest first, every output is a source for the ones below it
+	TArray<int32> Sorted;
+	for (int32 Size : Sizes)
+	{
+		if (Size > 0 && Size < Largest)
+		{
+			Sorted.AddUnique(Size);
+		}
+	}
+	Sorted.Sort(TGreater<int32>());
+
+	//Outputs point at each other, no reallocation while the chain is built
+	Image.ExtraOutputs.Reset(Sorted.Num());
+
+	const FColor* Source = Image.Pixels.GetData();
+	FIntPoint SourceSize = Image.Size;
+	for (int32 Size : Sorted)
+	{
+		//Reduce from the previous level when it divides, otherwise from the full image
+		if (!CanReduceTo(SourceSize, Size))
+		{
+			Source = Image.Pixels.GetData();
+			SourceSize = Image.Size;
+		}
+		if (!CanReduceTo(SourceSize, Size))
+		{
+			UE_LOG(LogThumbnailCreator, Warning, TEXT("Skipping %d output of %s, %dx%d is not a multiple of it"), Size, *Image.AssetName, Image.Size.X, Image.Size.Y);
+			continue;
+		}
+
+		const int32 Factor = FMath::Max(SourceSize.X, SourceSize.Y) / Size;
+
+		FThumbnailOutput& Output = Image.ExtraOutputs.AddDefaulted_GetRef();
+		Output.AssetName = FString::Printf(TEXT("%s_%d"), *Image.AssetName, Size);
+		Output.Size = FIntPoint(SourceSize.X / Factor, SourceSize.Y / Factor);
+		Output.Pixels.SetNumUninitialized(Output.Size.X * Output.Size.Y);
+		BoxReduce(Source, SourceSize, Factor, Output.Pixels.GetData());
+
+		Source = Output.Pixels.GetData();
+		SourceSize = Output.Size;
+	}
+}
+
+/*
+*	Write a filtered pixel back with straight alpha
+*
+*	@param	Premultiplied	Weighted sum of colors times their alpha
+*	@param	Straight		Weighted sum of the pixels, only alpha is used
+*	@param	InvWeight		One over the sum of the weights
+*	@param	Out				Output pixel
+*/
+static void StoreStraight(VectorRegister4Float Premultiplied, VectorRegister4Float Straight, float InvWeight, FColor& Out)
+{
+	const float AlphaSum = VectorGetComponent(Straight, 3);
+	if (AlphaSum <= 0.f)
+	{
+		Out = FColor(0, 0, 0, 0);
+		return;
+	}
+
+	//Back to straight alpha, covered sub pixels decide the color and the coverage decides the alpha
+	const VectorRegister4Float Color = VectorDivide(Premultiplied, VectorSetFloat1(AlphaSum));
+	const VectorRegister4Float Alpha = VectorSetFloat1(AlphaSum * InvWeight);
+	VectorStoreByte4(VectorAdd(VectorSelect(GlobalVectorConstants::XYZMask(), Color, Alpha), VectorSetFloat1(0.5f)), &Out);
+}
+
+bool FThumbnailResampler::CanReduceTo(FIntPoint ImageSize, int32 Size)
+{
+	const int32 Largest = FMath::Max(ImageSize.X, ImageSize.Y);
+	if (Size <= 0 || Size >= Largest || Largest % Size != 0)
+	{
+		return false;
+	}
+	const int32 Factor = Largest / Size;
+	return ImageSize.X % Factor == 0 && ImageSize.Y % Factor == 0;
+}
+
+void FThumbnailResampler::BoxReduce(const FColor* Source, FIntPoint SourceSize, int32 Factor, FColor* Dest)
+{
+	const FIntPoint DestSize(SourceSize.X / Factor, SourceSize.Y / Factor);
+	const float InvCount = 1.f / (Factor * Factor);
+
+	for (int32 Y = 0; Y < DestSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < DestSize.X; ++X)
+		{
+			//One BGRA pixel per register, colors summed premultiplied and alpha summed straight
+			VectorRegister4Float Premultiplied = VectorZeroFloat();
+			VectorRegister4Float Straight = VectorZeroFloat();
+			for (int32 SubY = 0; SubY < Factor; ++SubY)
+			{
+				const FColor* Row = Source + (Y * Factor + SubY) * SourceSize.X + X * Factor;
+				for (int32 SubX = 0; SubX < Factor; ++SubX)
+				{
+					const VectorRegister4Float Pixel = VectorLoadByte4(Row + SubX);
+					Premultiplied = VectorMultiplyAdd(Pixel, VectorReplicate(Pixel, 3), Premultiplied);
+					Straight = VectorAdd(Straight, Pixel);
+				}
+			}
+
+			StoreStraight(Premultiplied, Straight, InvCount, Dest[Y * DestSize.X + X]);
+		}
+	}
+}
+
+bool FThumbnailResampler::AutoCrop(FThumbnailImage& Image, float Padding, uint8 AlphaThreshold)
+{
+	if (Image.Size.X <= 0 || Image.Size.Y <= 0 || Image.Pixels.Num() != Image.Size.X * Image.Size.Y)
+	{
+		return false;
+	}
+
+	FIntRect Bounds;
+	if (!FindOpaqueBounds(Image.Pixels.GetData(), Image.Size, AlphaThreshold, Bounds))
+	{
+		return false;
+	}
+
+	//Smallest crop with the aspect ratio of the image that holds the asset and its padding
+	const float Aspect = (float)Image.Size.X / Image.Size.Y;
+	const float Fill = 1.f - 2.f * FMath::Clamp(Padding, 0.f, 0.4f);
+	const float CropWidth = FMath::Min(FMath::Max((float)Bounds.Width(), Bounds.Height() * Aspect) / Fill, (float)Image.Size.X);
+	const float Step = CropWidth / Image.Size.X;
+
+	const FVector2f Center((Bounds.Min.X + Bounds.Max.X) * 0.5f, (Bounds.Min.Y + Bounds.Max.Y) * 0.5f);
+	FVector2f Origin(Center.X - CropWidth * 0.5f, Center.Y - CropWidth / Aspect * 0.5f);
+	if (Step >= 1.f)
+	{
+		//Only centred, whole pixel offsets copy the pixels without blurring them
+		Origin = FVector2f(FMath::RoundToFloat(Origin.X), FMath::RoundToFloat(Origin.Y));
+		if (Origin.IsNearlyZero())
+		{
+			return true;
+		}
+	}
+
+	TArray<FColor> Dest;
+	Dest.SetNumUninitialized(Image.Pixels.Num());
+	Resample(Image.Pixels.GetData(), Image.Size, Origin, Step, Dest.GetData(), Image.Size);
+	Image.Pixels = MoveTemp(Dest);
+	return true;
+}
+
+bool FThumbnailResampler::FindOpaqueBounds(const FColor* Source, FIntPoint SourceSize, uint8 AlphaThreshold, FIntRect& OutBounds)
+{
+	const VectorRegister4Int Threshold = VectorIntSet1(AlphaThreshold);
+	const int32 VectorWidth = SourceSize.X & ~3;
+
+	int32 MinX = SourceSize.X;
+	int32 MinY = SourceSize.Y;
+	int32 MaxX = INDEX_NONE;
+	int32 MaxY = INDEX_NONE;
+	for (int32 Y = 0; Y < SourceSize.Y; ++Y)
+	{
+		const FColor* Row = Source + Y * SourceSize.X;
+		int32 First = INDEX_NONE;
+		int32 Last = INDEX_NONE;
+
+		int32 X = 0;
+		for (; X < VectorWidth; X += 4)
+		{
+			//Alpha is the top byte of every BGRA pixel, one bit per pixel above the threshold
+			const VectorRegister4Int Alpha = VectorShiftRightImmLogical(VectorIntLoad(Row + X), 24);
+			const uint32 Mask = (uint32)VectorMaskBits(VectorCastIntToFloat(VectorIntCompareGT(Alpha, Threshold)));
+			if (Mask != 0)
+			{
+				First = First == INDEX_NONE ? X + (int32)FMath::CountTrailingZeros(Mask) : First;
+				Last = X + 31 - (int32)FMath::CountLeadingZeros(Mask);
+			}
+		}
+		for (; X < SourceSize.X; ++X)
+		{
+			if (Row[X].A > AlphaThreshold)
+			{
+				First = First == INDEX_NONE ? X : First;
+				Last = X;
+			}
+		}
+
+		if (First != INDEX_NONE)
+		{
+			MinX = FMath::Min(MinX, First);
+			MaxX = FMath::Max(MaxX, Last);
+			MinY = FMath::Min(MinY, Y);
+			MaxY = Y;
+		}
+	}
+
+	if (MaxY == INDEX_NONE)
+	{
+		return false;
+	}
+	OutBounds = FIntRect(MinX, MinY, MaxX + 1, MaxY + 1);
+	return true;
+}
+
+void FThumbnailResampler::Resample(const FColor* Source, FIntPoint SourceSize, FVector2f Origin, float Step, FColor* Dest, FIntPoint DestSize)
+{
+	//Left source column and its weight are the same for every row
+	TArray<int32> Columns;
+	TArray<float> ColumnWeights;
+	Columns.SetNumUninitialized(DestSize.X);
+	ColumnWeights.SetNumUninitialized(DestSize.X);
+	for (int32 X = 0; X < DestSize.X; ++X)
+	{
+		const float SourceX = Origin.X + (X + 0.5f) * Step - 0.5f;
+		Columns[X] = FMath::FloorToInt32(SourceX);
+		ColumnWeights[X] = SourceX - Columns[X];
+	}
+
+	auto Fetch = [Source, SourceSize](int32 X, int32 Y)
+	{
+		return X >= 0 && Y >= 0 && X < SourceSize.X && Y < SourceSize.Y ? VectorLoadByte4(Source + Y * SourceSize.X + X) : VectorZeroFloat();
+	};
+
+	for (int32 Y = 0; Y < DestSize.Y; ++Y)
+	{
+		const float SourceY = Origin.Y + (Y + 0.5f) * Step - 0.5f;
+		const int32 Row = FMath::FloorToInt32(SourceY);
+		const float WeightY = SourceY - Row;
+
+		for (int32 X = 0; X < DestSize.X; ++X)
+		{
+			const int32 Column = Columns[X];
+			const float WeightX = ColumnWeights[X];
+			const VectorRegister4Float Pixels[4] = { Fetch(Column, Row), Fetch(Column + 1, Row), Fetch(Column, Row + 1), Fetch(Column + 1, Row + 1) };
+			const float Weights[4] = { (1.f - WeightX) * (1.f - WeightY), WeightX * (1.f - WeightY), (1.f - WeightX) * WeightY, WeightX * WeightY };
+
+			VectorRegister4Float Premultiplied = VectorZeroFloat();
+			VectorRegister4Float Straight = VectorZeroFloat();
+			for (int32 Corner = 0; Corner < 4; ++Corner)
+			{
+				const VectorRegister4Float Weighted = VectorMultiply(Pixels[Corner], VectorSetFloat1(Weights[Corner]));
+				Premultiplied = VectorMultiplyAdd(Weighted, VectorReplicate(Pixels[Corner], 3), Premultiplied);
+				Straight = VectorAdd(Straight, Weighted);
+			}
+
+			StoreStraight(Premultiplied, Straight, 1.f, Dest[Y * DestSize.X + X]);
+		}
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailScenePoolCaptureBackend.h"
+
+//Thumbnail Core
+#include "Pipeline/ThumbnailCaptureScene.h"
+#include "Pipeline/ThumbnailGPUReadback.h"
+#include "Objects/ThumbnailOptions.h"
+
+FThumbnailScenePoolCaptureBackend::FThumbnailScenePoolCaptureBackend(int32 NumScenes, int32 ProfileIndex)
+{
+	for (int32 Index = 0; Index < NumScenes; ++Index)
+	{
+		Scenes.Add(MakeUnique<FThumbnailCaptureScene>(ProfileIndex));
+	}
+}
+
+FThumbnailScenePoolCaptureBackend::~FThumbnailScenePoolCaptureBackend()
+{
+}
+
+bool FThumbnailScenePoolCaptureBackend::AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options)
+{
+	return Asset && Scenes[Slot]->SetAsset(Asset, Type, Options);
+}
+
+UPrimitiveComponent* FThumbnailScenePoolCaptureBackend::GetActiveComponent(int32 Slot) const
+{
+	return Scenes[Slot]->GetActiveComponent();
+}
+
+bool FThumbnailScenePoolCaptureBackend::CanBeginCapture(const UThumbnailOptions& Options) const
+{
+	return PendingReadbacks.Num() < FMath::Max(1, Options.ReadbacksInFlight);
+}
+
+void FThumbnailScenePoolCaptureBackend::Capture(int32 Slot, const UThumbnailOptions& Options)
+{
+	//A failed capture has no readback, it is reported empty on the next poll like any other capture
+	FPendingReadback& Pending = PendingReadbacks.AddDefaulted_GetRef();
+	Pending.Slot = Slot;
+	Pending.Readback = Scenes[Slot]->Capture(Options, ManualView);
+}
+
+bool FThumbnailScenePoolCaptureBackend::PollReadbacks()
+{
+	//The pipeline matches images to assets by the order of their slot, a newer copy that finished first waits for the older one
+	TBitArray<> BlockedSlots(false, Scenes.Num());
+
+	bool bReported = false;
+	for (int32 Index = 0; Index < PendingReadbacks.Num();)
+	{
+		FPendingReadback& Pending = PendingReadbacks[Index];
+		if (BlockedSlots[Pending.Slot])
+		{
+			++Index;
+			continue;
+		}
+
+		FThumbnailImage Image;
+		if (Pending.Readback.IsValid() && !Pending.Readback->Poll(Image))
+		{
+			BlockedSlots[Pending.Slot] = true;
+			++Index;
+			continue;
+		}
+
+		const int32 Slot = Pending.Slot;
+		PendingReadbacks.RemoveAt(Index);
+		OnCaptured.ExecuteIfBound(Slot, Image);
+		bReported = true;
+	}
+	return bReported;
+}
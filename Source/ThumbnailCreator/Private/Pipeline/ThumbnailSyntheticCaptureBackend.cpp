@@ -0,0 +1,52 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailSyntheticCaptureBackend.h"
+
+//Thumbnail Core
+#include "Objects/ThumbnailOptions.h"
+
+FThumbnailSyntheticCaptureBackend::FThumbnailSyntheticCaptureBackend(int32 NumSlots)
+{
+	AssetNames.SetNum(FMath::Max(1, NumSlots));
+}
+
+bool FThumbnailSyntheticCaptureBackend::AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+	AssetNames[Slot] = Asset->GetName();
+	return true;
+}
+
+void FThumbnailSyntheticCaptureBackend::Capture(int32 Slot, const UThumbnailOptions& Options)
+{
+	FThumbnailImage Image;
+	Image.AssetName = "Thumb_" + AssetNames[Slot];
+	Image.Supersample = FMath::Max(1, Options.GetCaptureProfile().Supersample);
+	Image.Size = FIntPoint(Options.ScreenshotXSize, Options.ScreenshotYSize) * Image.Supersample;
+	if (Image.Size.X > 0 && Image.Size.Y > 0)
+	{
+		FillImage(Image);
+	}
+	OnCaptured.ExecuteIfBound(Slot, Image);
+}
+
+void FThumbnailSyntheticCaptureBackend::FillImage(FThumbnailImage& Image)
+{
+	//Gradient tinted by the name, with a transparent border like a real capture around its asset
+	const FColor Tint = FColor::MakeRandomSeededColor(GetTypeHash(Image.AssetName));
+	const int32 Border = FMath::Min(Image.Size.X, Image.Size.Y) / 8;
+
+	Image.Pixels.SetNumUninitialized(Image.Size.X * Image.Size.Y);
+	for (int32 Y = 0; Y < Image.Size.Y; ++Y)
+	{
+		for (int32 X = 0; X < Image.Size.X; ++X)
+		{
+			const bool bInside = X >= Border && Y >= Border && X < Image.Size.X - Border && Y < Image.Size.Y - Border;
+			const uint8 Shade = (uint8)((X + Y) * 255 / FMath::Max(1, Image.Size.X + Image.Size.Y - 2));
+			Image.Pixels[Y * Image.Size.X + X] = bInside ? FColor((Tint.R + Shade) / 2, (Tint.G + Shade) / 2, (Tint.B + Shade) / 2, 255) : FColor(0, 0, 0, 0);
+		}
+	}
+}
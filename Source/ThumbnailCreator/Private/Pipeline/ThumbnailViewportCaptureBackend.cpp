@@ -0,0 +1,67 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Pipeline/ThumbnailViewportCaptureBackend.h"
+
+//Thumbnail Core
+#include "ThumbnailCreator.h"
+#include "Client/ThumbnailViewportClient.h"
+#include "Slate/SThumbnailViewport.h"
+
+FThumbnailViewportCaptureBackend::FThumbnailViewportCaptureBackend(FThumbnailCreatorModule& InModule)
+	: Module(InModule)
+{
+}
+
+bool FThumbnailViewportCaptureBackend::IsAvailable() const
+{
+	//Without the tab there is no viewport to capture with
+	return bAvailable && Module.ViewportPtr.IsValid();
+}
+
+bool FThumbnailViewportCaptureBackend::AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options)
+{
+	return IsAvailable() && Module.AssignAsset(Asset, Type, false);
+}
+
+UPrimitiveComponent* FThumbnailViewportCaptureBackend::GetActiveComponent(int32 Slot) const
+{
+	return IsAvailable() ? Module.ViewportPtr->GetViewportClient()->GetActiveComponent() : nullptr;
+}
+
+void FThumbnailViewportCaptureBackend::Capture(int32 Slot, const UThumbnailOptions& Options)
+{
+	if (!IsAvailable())
+	{
+		FThumbnailImage Failed;
+		OnCaptured.ExecuteIfBound(0, Failed);
+		return;
+	}
+
+	//The viewport client reads the shot back and reports through OnViewportReadback
+	Module.ViewportPtr->GetViewportClient()->TakeSingleShot();
+}
+
+FString FThumbnailViewportCaptureBackend::GetAssetName() const
+{
+	return IsAvailable() ? Module.ViewportPtr->GetViewportClient()->GetAssetName() : FString();
+}
+
+void FThumbnailViewportCaptureBackend::SetAvailable(bool bInAvailable)
+{
+	//A closed viewport never paints, so a requested shot would never come back
+	if (!bInAvailable && Module.ViewportPtr.IsValid())
+	{
+		Module.ViewportPtr->GetViewportClient()->CancelPendingShot();
+	}
+	bAvailable = bInAvailable;
+}
+
+void FThumbnailViewportCaptureBackend::OnViewportReadback(FThumbnailImage&& Image)
+{
+	//Slots were already failed when the tab closed
+	if (!bAvailable)
+	{
+		return;
+	}
+	OnCaptured.ExecuteIfBound(0, Image);
+}
@@ -0,0 +1,166 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#include "Slate/SThumbnailProgress.h"
+
+//Thumbnail Core
+#include "Pipeline/ThumbnailPipeline.h"
+
+//Slate
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Notifications/SProgressBar.h"
+
+//Often enough to read, rare enough to not show up in a profile
+static const float RefreshPeriod = 0.25f;
+
+void SThumbnailProgress::Construct(const FArguments& InArgs, const TSharedRef<FThumbnailPipeline>& InPipeline)
+{
+	Pipeline = InPipeline;
+	BatchStartedHandle = InPipeline->OnBatchStarted.AddSP(this, &SThumbnailProgress::OnBatchStarted);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0, 0, 0, 2)
+		[
+			SAssignNew(StatusText, STextBlock)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0, 0, 0, 2)
+		[
+			SAssignNew(ProgressBar, SProgressBar)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0, 0, 0, 2)
+		[
+			SAssignNew(StagesText, STextBlock)
+			.AutoWrapText(true)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0, 0, 0, 2)
+		[
+			SAssignNew(ResultText, STextBlock)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SAssignNew(CancelButton, SButton)
+			.OnClicked(this, &SThumbnailProgress::OnCancelClicked)
+			[
+				SNew(STextBlock).Text(FText::FromString("Cancel"))
+			]
+		]
+	];
+
+	//Tab may open while a batch is running
+	if (!InPipeline->IsIdle())
+	{
+		OnBatchStarted();
+	}
+	Refresh();
+}
+
+SThumbnailProgress::~SThumbnailProgress()
+{
+	if (TSharedPtr<FThumbnailPipeline> Pinned = Pipeline.Pin())
+	{
+		Pinned->OnBatchStarted.Remove(BatchStartedHandle);
+	}
+}
+
+void SThumbnailProgress::OnBatchStarted()
+{
+	if (TSharedPtr<FThumbnailPipeline> Pinned = Pipeline.Pin())
+	{
+		const FThumbnailPipelineStats& Stats = Pinned->GetStats();
+		BatchStartTime = FPlatformTime::Seconds();
+		BatchStartFinished = Stats.Imported + Stats.Failed;
+	}
+
+	if (!ActiveTimer.IsValid())
+	{
+		ActiveTimer = RegisterActiveTimer(RefreshPeriod, FWidgetActiveTimerDelegate::CreateSP(this, &SThumbnailProgress::UpdateProgress));
+	}
+}
+
+EActiveTimerReturnType SThumbnailProgress::UpdateProgress(double InCurrentTime, float InDeltaTime)
+{
+	Refresh();
+
+	TSharedPtr<FThumbnailPipeline> Pinned = Pipeline.Pin();
+	if (!Pinned.IsValid() || Pinned->IsIdle())
+	{
+		ActiveTimer.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+	return EActiveTimerReturnType::Continue;
+}
+
+void SThumbnailProgress::Refresh()
+{
+	TSharedPtr<FThumbnailPipeline> Pinned = Pipeline.Pin();
+	if (!Pinned.IsValid())
+	{
+		return;
+	}
+
+	const FThumbnailPipelineStats& Stats = Pinned->GetStats();
+	const bool bRunning = !Pinned->IsIdle();
+
+	//Everything still between the queue and the import
+	int32 Remaining = 0;
+	for (EThumbnailStage Stage : { EThumbnailStage::Assign, EThumbnailStage::Ready, EThumbnailStage::Capture, EThumbnailStage::Readback, EThumbnailStage::Decode, EThumbnailStage::Import })
+	{
+		Remaining += Pinned->GetStageDepth(Stage);
+	}
+
+	const int32 Finished = Stats.Imported + Stats.Failed - BatchStartFinished;
+	const double Seconds = FPlatformTime::Seconds() - BatchStartTime;
+	const double Rate = Seconds > 0.0 ? Finished / Seconds : 0.0;
+	const int32 FoldersLeft = Pinned->GetNumFoldersLeft();
+
+	if (bRunning)
+	{
+		FString Status = FString::Printf(TEXT("%d of %d done, %.1f/s"), Finished, Finished + Remaining, Rate);
+		if (Rate > 0.0)
+		{
+			Status += TEXT(", ETA ") + FText::AsTimespan(FTimespan::FromSeconds(Remaining / Rate)).ToString();
+		}
+		if (FoldersLeft > 0)
+		{
+			Status += FString::Printf(TEXT(", %d folders left to query"), FoldersLeft);
+		}
+		StatusText->SetText(FText::FromString(Status));
+		ProgressBar->SetPercent(Finished + Remaining > 0 ? (float)Finished / (Finished + Remaining) : 0.f);
+	}
+	else
+	{
+		StatusText->SetText(FText::FromString(Finished > 0 ? FString::Printf(TEXT("Idle, last batch finished %d"), Finished) : FString(TEXT("Idle"))));
+		ProgressBar->SetPercent(Finished > 0 ? 1.f : 0.f);
+	}
+
+	StagesText->SetText(FText::FromString(FString::Printf(TEXT("Assign %d  Ready %d  Capture %d  Readback %d  Decode %d  Import %d  Save %d  In flight %d"),
+		Pinned->GetStageDepth(EThumbnailStage::Assign), Pinned->GetStageDepth(EThumbnailStage::Ready), Pinned->GetStageDepth(EThumbnailStage::Capture),
+		Pinned->GetStageDepth(EThumbnailStage::Readback), Pinned->GetStageDepth(EThumbnailStage::Decode), Pinned->GetStageDepth(EThumbnailStage::Import),
+		Pinned->GetStageDepth(EThumbnailStage::Save), Pinned->GetImagesInFlight())));
+
+	ResultText->SetText(FText::FromString(FString::Printf(TEXT("Imported %d  Unchanged %d  Skipped %d  Failed %d"), Stats.Imported, Stats.Unchanged, Stats.Skipped, Stats.Failed)));
+
+	CancelButton->SetEnabled(bRunning);
+}
+
+FReply SThumbnailProgress::OnCancelClicked()
+{
+	if (TSharedPtr<FThumbnailPipeline> Pinned = Pipeline.Pin())
+	{
+		Pinned->Cancel();
+		Refresh();
+	}
+	return FReply::Handled();
+}
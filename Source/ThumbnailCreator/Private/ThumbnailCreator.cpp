@@ -7,7 +7,6 @@
 #include "PreviewScene.h"
 #include "Editor.h"
 #include "Engine/SkeletalMesh.h"
-#include "Runtime/Core/Public/Containers/Ticker.h"
 
 //Thumbnail Core
 #include "Client/ThumbnailViewportClient.h"
@@ -15,19 +14,18 @@
 #include "Runtime/Engine/Classes/Animation/AnimationAsset.h"
 #include "ThumbnailCreatorCommands.h"
 #include "ThumbnailCreatorStyle.h"
+#include "Pipeline/ThumbnailPipeline.h"
+#include "Pipeline/ThumbnailViewportCaptureBackend.h"
+#include "Pipeline/ThumbnailAssetPrefetcher.h"
+#include "Slate/SThumbnailProgress.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/SkeletalMesh.h"
 
 //Image
-#include "Runtime/Core/Public/Misc/FileHelper.h"
-#include "Runtime/Engine/Classes/EditorFramework/AssetImportData.h"
-#include "Editor/UnrealEd/Classes/Factories/TextureFactory.h"
-#include "Engine/Texture2D.h"
 #include "Runtime/Core/Public/HAL/FileManager.h"
-#include "Runtime/ImageWrapper/Public/IImageWrapper.h"
-#include "Runtime/ImageWrapper/Public/IImageWrapperModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Runtime/Core/Public/Misc/Paths.h"
+#include "Async/Async.h"
 
 //Slate
 #include "Widgets/Docking/SDockTab.h"
@@ -41,6 +39,9 @@
 #include "Widgets/Images/SImage.h"
 #include "Editor/PropertyEditor/Public/IDetailsView.h"
 
+DEFINE_LOG_CATEGORY(LogThumbnailCreator);
+DEFINE_STAT(STAT_ThumbnailBytesWritten);
+
 static const FName ThumbnailCreatorTabName("ThumbnailCreator");
 
 #define LOCTEXT_NAMESPACE "FThumbnailCreatorModule"
@@ -82,22 +83,6 @@ void FThumbnailCreatorModule::StartupModule()
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
 
 
-	//Setup a timer every 0.03 seconds to crete a new image or process taken image
-	ImageTickDelegate = FTickerDelegate::CreateRaw(this, &FThumbnailCreatorModule::NextInQueue);
-	FTSTicker::GetCoreTicker().AddTicker(ImageTickDelegate, 0.03f);
-
-
-	//Get all startup images to exclude from processing
-	IFileManager& FileManager = IFileManager::Get();
-	
-	TArray<FString> StartUpShort;
-	FileManager.FindFiles(StartUpShort, *Path);
-	for (FString Short : StartUpShort)
-	{
-		//Add path because Short is just the name, we still need to add the path to the string
-		StartupImages.Add(Path + Short);
-	}
-
 	//THIS IS NEEDED, if you don't do this you will crash the engine upon shutdown
 	FCoreDelegates::OnPreExit.AddLambda([this]()
 	{
@@ -116,6 +101,7 @@ void FThumbnailCreatorModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	Pipeline.Reset();
 
 	FThumbnailCreatorStyle::Shutdown();
 
@@ -135,6 +121,10 @@ TSharedRef<SDockTab> FThumbnailCreatorModule::OnSpawnPluginTab(const FSpawnTabAr
 
 	//Create the new SThumbnailViewport for this tab
 	ViewportPtr = SNew(SThumbnailViewport);
+	if (Pipeline.IsValid())
+	{
+		Pipeline->SetViewportAvailable(true);
+	}
 
 	//Setup thumbnail options property details view settings
 	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
@@ -158,8 +148,12 @@ TSharedRef<SDockTab> FThumbnailCreatorModule::OnSpawnPluginTab(const FSpawnTabAr
 		ThumbnailOptions->AddToRoot();
 	}
 
+	//Screenshots of the viewport are picked up from here on
+	GetPipeline();
+
 	auto var = SNew(SDockTab)
 		.TabRole(ETabRole::NomadTab)
+		.OnTabClosed_Raw(this, &FThumbnailCreatorModule::OnPluginTabClosed)
 		[
 			// Put your tab content here!
 
@@ -210,6 +204,12 @@ TSharedRef<SDockTab> FThumbnailCreatorModule::OnSpawnPluginTab(const FSpawnTabAr
 				]
 				+ SVerticalBox::Slot()
 				.Padding(5, 0, 5, 10)
+				.HAlign(HAlign_Fill).VAlign(VAlign_Top).AutoHeight()
+				[
+					SNew(SThumbnailProgress, GetPipeline().AsShared())
+				]
+				+ SVerticalBox::Slot()
+				.Padding(5, 0, 5, 10)
 				.HAlign(HAlign_Fill).VAlign(VAlign_Fill).AutoHeight()
 				[
 					DetailsView->AsShared()
@@ -256,6 +256,50 @@ TSharedRef<SDockTab> FThumbnailCreatorModule::OnSpawnPluginTab(const FSpawnTabAr
 	return var;
 }
 
+void FThumbnailCreatorModule::OnPluginTabClosed(TSharedRef<SDockTab> Tab)
+{
+	if (!Pipeline.IsValid())
+	{
+		return;
+	}
+
+	//Viewport shots fail right away, offscreen work keeps draining without the tab
+	Pipeline->SetViewportAvailable(false);
+	if (Pipeline->IsIdle())
+	{
+		Pipeline.Reset();
+	}
+}
+
+FThumbnailPipeline& FThumbnailCreatorModule::GetPipeline()
+{
+	//Pipeline only runs when work is queued, every stage is started by the one before it
+	if (!Pipeline.IsValid())
+	{
+		Pipeline = MakeShareable(new FThumbnailPipeline(*this));
+		Pipeline->OnIdle.AddRaw(this, &FThumbnailCreatorModule::OnPipelineIdle);
+	}
+	return *Pipeline;
+}
+
+void FThumbnailCreatorModule::OnPipelineIdle()
+{
+	//Commandlets read the stats once the run is idle, the tab keeps its pipeline
+	if (IsRunningCommandlet() || !Pipeline.IsValid() || Pipeline->GetViewportBackend().IsAvailable())
+	{
+		return;
+	}
+
+	//Broadcast from inside the pump, the pipeline goes away on the next frame
+	AsyncTask(ENamedThreads::GameThread, [this]()
+	{
+		if (Pipeline.IsValid() && Pipeline->IsIdle() && !Pipeline->GetViewportBackend().IsAvailable())
+		{
+			Pipeline.Reset();
+		}
+	});
+}
+
 void FThumbnailCreatorModule::PluginButtonClicked()
 {
 	//FGlobalTabmanager::Get()->InvokeTab(ThumbnailCreatorTabName);
@@ -273,8 +317,8 @@ FReply FThumbnailCreatorModule::GenerateFromSelection()
 	TArray<FAssetData> Selection;
 	GEditor->GetContentBrowserSelections(Selection);
 
-	//Set selection as queue
-	Queue = Selection;
+	//Queue the selection in the pipeline
+	GetPipeline().EnqueueAssets(Selection);
 
 	return FReply::Handled();
 }
@@ -297,7 +341,7 @@ FReply FThumbnailCreatorModule::PreviewSelected()
 FReply FThumbnailCreatorModule::GenerateView()
 {
 	//Take a screnshot of the current view
-	ViewportPtr->GetViewportClient()->TakeSingleShot();
+	GetPipeline().EnqueueCurrentView();
 	return FReply::Handled();
 }
 
@@ -308,166 +352,56 @@ FReply FThumbnailCreatorModule::UpdateViewportTransform()
 	return FReply::Handled();
 }
 
-bool FThumbnailCreatorModule::NextInQueue(float Delta)
+void FThumbnailCreatorModule::AddToolbarExtension(FToolBarBuilder& Builder)
 {
-	//If we have a queue(FAssetData)
-	if (Queue.Num() > 0)
-	{
-		//Take the firs tin queue
-		FAssetData _Data = Queue[0];
-		//Delete from queue
-		Queue.RemoveAt(0);
-		AssignAsset(_Data, true);
-
-	}
-	//If we have created images...
-	else if(CreatedImages.Num() > 0)
-	{
-		TArray<uint8> RawImage;
-
-		//get first created image and remove from queu
-		FString pngfile = CreatedImages[0];
-		CreatedImages.RemoveAt(0);
+	Builder.AddToolBarButton(FThumbnailCreatorCommands::Get().OpenPluginWindow);
+}
 
-		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-		// Note: PNG format.  Other formats are supported
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
 
-		if (FFileHelper::LoadFileToArray(RawImage, *pngfile))
-		{
-			if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(RawImage.GetData(), RawImage.Num()))
-			{
-				TArray64<uint8> UncompressedBGRA;
-				if (ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
-				{
-					// Setup packagename
-					FString AssetName = pngfile.RightChop(pngfile.Find("/", ESearchCase::IgnoreCase, ESearchDir::FromEnd) + 1);
-					FString USeAssetName = AssetName.LeftChop(AssetName.Len() - AssetName.Find( ".png", ESearchCase::IgnoreCase, ESearchDir::FromEnd));
-
-					FString PackageName = TEXT("/Game/ThumbnailExports/" + USeAssetName);
-					// Create new UPackage from PackageName
-					UPackage* Package = CreatePackage(*PackageName);
-					//Try to get the old package if this image already exists
-					UPackage* OldPackage = LoadPackage(NULL, *PackageName,0);
-
-					// Create Texture2D Factory
-					auto TextureFact = NewObject<UTextureFactory>();
-					TextureFact->AddToRoot();
-					TextureFact->SuppressImportOverwriteDialog();
-
-					// Get a pointer to the raw image data
-					const uint8* PtrTexture = RawImage.GetData();
-
-					// Stupidly use the damn factory
-					UTexture2D* Texture = (UTexture2D*)TextureFact->FactoryCreateBinary(UTexture2D::StaticClass(), OldPackage? OldPackage : Package, *USeAssetName, RF_Standalone | RF_Public, NULL, TEXT("png"), PtrTexture, PtrTexture + RawImage.Num(), GWarn);
-					
-					if (Texture)
-					{
-						Texture->AssetImportData->Update(IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*USeAssetName));
-						
-						Package->SetDirtyFlag(true);
-						TextureFact->RemoveFromRoot();
-
-						//If we already have an old package we don't want to overwrite settings to defaults
-						if (!OldPackage)
-						{
-							Texture->UpdateResource();
-							//Set settings to fit with UI
-							Texture->Filter = TextureFilter::TF_Trilinear;
-							//2D pixels for UI gives clearest results
-							Texture->LODGroup = TextureGroup::TEXTUREGROUP_UI;
-							//Add chroma key
-							Texture->bChromaKeyTexture = true;
-							Texture->ChromaKeyColor = FColor(0,255,0,0);
-							Texture->UpdateResource();
-						}
-						//Notify new asset created or store in the old package
-						if (OldPackage)
-						{
-							OldPackage->SetDirtyFlag(true);
-						}
-						else
-						{
-							FAssetRegistryModule::AssetCreated(Texture);
-						}
-					}
-				}
-			}
-		}
-	}
-	//If none of the above
-	else
+bool FThumbnailCreatorModule::AssignAsset(FAssetData _Data, bool bTakeShot)
+{
+	//Resolve the type first, so unsupported assets are never loaded
+	const EThumbnailAssetType Type = FThumbnailAssetPrefetcher::ResolveAssetType(_Data);
+	if (Type == EThumbnailAssetType::Unsupported)
 	{
-		TArray<FString> AllImages;
-
-		//Get all images in teh screenshot folter
-		IFileManager& FileManager = IFileManager::Get();
-		FileManager.FindFiles(AllImages, *Path);
-		for (FString Image : AllImages)
-		{
-			//Format full string
-			FString Full = Path + Image;
-			//If this image isn't in the startup(so wasn't known about before) we know it's new and we should process
-			if (!StartupImages.Contains(Full))
-			{
-				//Add to startup images to prevent processing again
-				StartupImages.Add(Full);
-				CreatedImages.Add(Full);
-			}
-		}
+		return false;
 	}
 
-	return true;
+	return AssignAsset(_Data.GetAsset(), Type, bTakeShot);
 }
 
-//remove from startup images so we can process the image again
-void FThumbnailCreatorModule::RemoveFromPreKnown(const FString ToRemove)
+bool FThumbnailCreatorModule::AssignAsset(UObject* Asset, EThumbnailAssetType Type, bool bTakeShot)
 {
-	FString ToUseString = Path  + "Thumb_" + ToRemove + ".png";
-	StartupImages.Remove(ToUseString);
-}
-
-void FThumbnailCreatorModule::AddToolbarExtension(FToolBarBuilder& Builder)
-{
-	Builder.AddToolBarButton(FThumbnailCreatorCommands::Get().OpenPluginWindow);
-}
-
-
-void FThumbnailCreatorModule::AssignAsset(FAssetData _Data, bool bTakeShot)
-{
-	//Cast to static mesh
-	UStaticMesh* Mesh = Cast<UStaticMesh>(_Data.GetAsset());
-	if (Mesh)
+	if (!Asset)
 	{
-		//If static mesh, set the static mesh and take a screenshot
-		ViewportPtr->SetMesh(Mesh, bTakeShot);
-
-		return;
+		return false;
 	}
 
-	//If not a mesh... try a skeletal mesh
-	USkeletalMesh* SkelMesh = Cast<USkeletalMesh>(_Data.GetAsset());
-	if (SkelMesh)
+	switch (Type)
 	{
-		ViewportPtr->GetViewportClient()->SetSkelMesh(SkelMesh, nullptr, bTakeShot);
+	case EThumbnailAssetType::StaticMesh:
+		//If static mesh, set the static mesh and take a screenshot
+		ViewportPtr->SetMesh(CastChecked<UStaticMesh>(Asset), bTakeShot);
+		return true;
 
-		return;
-	}
+	case EThumbnailAssetType::SkeletalMesh:
+		ViewportPtr->GetViewportClient()->SetSkelMesh(CastChecked<USkeletalMesh>(Asset), nullptr, bTakeShot);
+		return true;
 
-	//If also not a skeletal mesh... try an animation
-	UAnimationAsset* AnimationAsset = Cast<UAnimationAsset>(_Data.GetAsset());
-	if (AnimationAsset)
+	case EThumbnailAssetType::Animation:
 	{
+		//Animations are shown on the preview mesh of their skeleton
+		UAnimationAsset* AnimationAsset = CastChecked<UAnimationAsset>(Asset);
 		ViewportPtr->GetViewportClient()->SetSkelMesh(AnimationAsset->GetSkeleton()->GetPreviewMesh(), AnimationAsset, bTakeShot);
-		return;
+		return true;
 	}
 
-	//If also not a skeletal mesh... try an animation
-	UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(_Data.GetAsset());
-	if (MaterialAsset)
-	{
-		ViewportPtr->GetViewportClient()->SetMaterial(MaterialAsset, bTakeShot);
-		return;
+	case EThumbnailAssetType::Material:
+		ViewportPtr->GetViewportClient()->SetMaterial(CastChecked<UMaterialInterface>(Asset), bTakeShot);
+		return true;
+
+	default:
+		return false;
 	}
 }
 
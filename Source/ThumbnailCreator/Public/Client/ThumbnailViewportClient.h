@@ -47,13 +47,33 @@ public:
 	EScreenshotType ActiveType;
 
 	//Options file
-	class UThumbnailOptions* ThumbnailOptions;
+	class UThumbnailOptions* ThumbnailOptions = nullptr;
+
+	//Asset name of the requested shot that will be read back for the pipeline
+	FString PendingCaptureName;
+	//Factor the requested shot is larger than the output
+	int32 PendingSupersample = 1;
 
 	virtual void Tick(float DeltaSeconds) override;
+	//Input keeps the viewport realtime for a moment
+	virtual bool InputKey(const FInputKeyEventArgs& EventArgs) override;
+	virtual bool InputAxis(FViewport* InViewport, FInputDeviceId DeviceID, FKey Key, float Delta, float DeltaTime, int32 NumSamples = 1, bool bGamepad = false) override;
+	//Reads back or notifies the pipeline once a requested shot has been rendered
+	virtual bool ProcessScreenShots(FViewport* InViewport) override;
 
 	//Take one single shot
 	void TakeSingleShot();
 
+	//Forget a requested shot that will never be read back because the viewport stopped painting
+	void CancelPendingShot();
+
+	/*
+	*	Called by the pipeline when it starts or stops using the viewport, keeps it realtime meanwhile
+	*
+	*	@param	bBusy		Is an asset waiting in the viewport or a shot of it requested?
+	*/
+	void SetPipelineBusy(bool bBusy);
+
 	//Update transform
 	void UpdateViewportTransform(const int32 FOV, const double Pitch, const double Yaw, const float Zoom);
 	
@@ -88,4 +108,35 @@ public:
 	*	Get the name of the active asset
 	*/
 	FString GetAssetName();
+
+	/*
+	*	Get the component showing the active asset
+	*/
+	UPrimitiveComponent* GetActiveComponent() const;
+
+private:
+
+	//Apply the LOD and show flags of the capture profile for the current size, only for the duration of a shot
+	void ApplyCaptureProfile();
+
+	//Give the interactive preview its own show flags and automatic LOD back after a shot
+	void RestoreCaptureProfile();
+
+	//Should the preview render and tick every frame right now?
+	bool WantsRealtime() const;
+
+	//Switch between realtime and on demand redraws when the reason for realtime changed
+	void UpdateRealtime();
+
+	//Realtime state we last asked for, realtime overrides of the editor are left alone
+	bool bRealtimeRequested = true;
+
+	//Time of the last input in the viewport
+	double LastInputTime = 0.0;
+
+	//Is the pipeline using the viewport?
+	bool bPipelineBusy = false;
+
+	//Show flags of the preview while a shot with the capture profile is pending
+	TOptional<FEngineShowFlags> PreviewShowFlags;
 };
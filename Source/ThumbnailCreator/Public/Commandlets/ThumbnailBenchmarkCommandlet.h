@@ -0,0 +1,38 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/ThumbnailCreatorCommandlet.h"
+#include "ThumbnailBenchmarkCommandlet.generated.h"
+
+/*
+*	Runs fixed batches of engine cubes, skeletal cubes and material instances through the pipeline and writes the results as json.
+*
+*	UnrealEditor-Cmd.exe Project.uproject -run=ThumbnailBenchmark [-Count=32] [-Sizes=256+512+2048] [-Output=Benchmark.json] [-<Option>=<Value>...]
+*
+*	Captures go through the synthetic backend so it runs on machines without a gpu, the assets are copies in /Temp and nothing is saved.
+*	Every run reports assets per second, p50/p95 latency of every stage and peak memory.
+*/
+UCLASS()
+class THUMBNAILCREATOR_API UThumbnailBenchmarkCommandlet : public UThumbnailCreatorCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	//UCommandlet
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	/*
+	*	Create unique copies of the benchmark assets
+	*
+	*	@param	Count		Copies of every asset kind
+	*	@param	Size		Resolution of the run, keeps the names of different runs apart
+	*	@param	OutObjects	Created objects, to release them after the run
+	*	@return	Asset data of the copies in queue order
+	*/
+	static TArray<FAssetData> CreateBenchmarkAssets(int32 Count, int32 Size, TArray<UObject*>& OutObjects);
+};
@@ -0,0 +1,41 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ThumbnailCreatorCommandlet.generated.h"
+
+/*
+*	Generates thumbnails without the tab, for build machines.
+*
+*	UnrealEditor-Cmd.exe Project.uproject -run=ThumbnailCreator -Paths=/Game/Props+/Game/Weapons [-Classes=StaticMesh+Material] [-Tags=Key:Value+Key] [-NonRecursive] [-<Option>=<Value>...]
+*
+*	Every property of UThumbnailOptions can be overridden by name, e.g. -ScreenshotXSize=256 -CaptureBackend=Synthetic.
+*	Captures go through the scene pool unless CaptureBackend is overridden, the tab viewport does not exist here.
+*/
+UCLASS()
+class THUMBNAILCREATOR_API UThumbnailCreatorCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UThumbnailCreatorCommandlet();
+
+	//UCommandlet
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	/*
+	*	Apply -<Option>=<Value> overrides to the options
+	*
+	*	@param	Options		Options to change
+	*	@param	ParamsMap	Parsed command line values
+	*/
+	static void ApplyOptionOverrides(class UThumbnailOptions* Options, const TMap<FString, FString>& ParamsMap);
+
+	//Tick everything the pipeline waits on until it is idle
+	static void RunUntilIdle(class FThumbnailPipeline& Pipeline);
+};
@@ -5,6 +5,62 @@
 #include "CoreMinimal.h"
 #include "ThumbnailOptions.generated.h"
 
+//Where queued assets are captured
+UENUM()
+enum class EThumbnailCaptureBackend : uint8
+{
+	//One asset at a time through the tab viewport
+	Viewport,
+	//Several offscreen scenes, each holding its own asset
+	ScenePool,
+	//Generated pixels without rendering, for benchmarking the other stages on machines without a gpu
+	Synthetic
+};
+
+//Render quality for outputs up to a size, small icons don't need the cost of a full quality render
+USTRUCT()
+struct THUMBNAILCREATOR_API FThumbnailCaptureProfile
+{
+	GENERATED_BODY()
+
+	//Used for outputs whose largest side is at most this size
+	UPROPERTY(EditAnywhere, Category = "Profile", meta = (ClampMin = "1"))
+		int32 MaxSize = 512;
+
+	//Mesh LOD to render, 0 lets the engine pick, 1 is LOD0, 2 is LOD1 and so on
+	UPROPERTY(EditAnywhere, Category = "Profile", meta = (ClampMin = "0", UIMax = "8"))
+		int32 ForcedLod = 0;
+
+	//Pixels rendered per output pixel along each axis
+	UPROPERTY(EditAnywhere, Category = "Profile", meta = (ClampMin = "1", ClampMax = "4"))
+		int32 Supersample = 2;
+
+	UPROPERTY(EditAnywhere, Category = "Profile")
+		bool bDynamicShadows = true;
+
+	UPROPERTY(EditAnywhere, Category = "Profile")
+		bool bAmbientOcclusion = true;
+
+	UPROPERTY(EditAnywhere, Category = "Profile")
+		bool bScreenSpaceReflections = true;
+
+	UPROPERTY(EditAnywhere, Category = "Profile")
+		bool bMotionBlur = false;
+
+	/*
+	*	Turn the costly features of the profile on or off
+	*
+	*	@param	ShowFlags	Show flags of the view or scene capture
+	*/
+	void ApplyToShowFlags(FEngineShowFlags& ShowFlags) const;
+
+	/*
+	*	Force the LOD of the profile on a mesh component, other components are left alone
+	*
+	*	@param	Component	Component showing the asset
+	*/
+	void ApplyToComponent(class UPrimitiveComponent* Component) const;
+};
 
 UCLASS(Transient)
 class THUMBNAILCREATOR_API UThumbnailOptions : public UObject
@@ -23,6 +79,22 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Setup")
 		bool bUseAutoSize = true;
 
+	//Keep captured pixels in memory only, when off a png copy is also written to Saved/Thumbnails
+	UPROPERTY(EditAnywhere, Category = "Setup")
+		bool bCaptureToMemory = true;
+
+	//Skip assets that were not saved since their thumbnail was generated with the same options
+	UPROPERTY(EditAnywhere, Category = "Setup")
+		bool bSkipUnchanged = true;
+
+	//Smaller copies of every thumbnail by their largest side, saved as Thumb_<name>_<size> and reduced from the one capture. Sizes have to divide the screenshot size
+	UPROPERTY(EditAnywhere, Category = "Setup", meta = (ClampMin = "1"))
+		TArray<int32> ExtraOutputSizes;
+
+	//Max difference of any color channel for a capture to count as unchanged, unchanged textures are not re-imported or dirtied
+	UPROPERTY(EditAnywhere, Category = "Setup", meta = (ClampMin = "0", ClampMax = "255"))
+		int32 PixelTolerance = 0;
+
 	UPROPERTY(EditAnywhere, Category = "Viewport")
 		double ThumbnailPitch = -11.25;
 
@@ -34,5 +106,66 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "Viewport")
 		int32 FOV = 30;
-	
+
+	//Render the preview every frame, when off it only renders while you move the camera, an animation plays or a shot is taken
+	UPROPERTY(EditAnywhere, Category = "Viewport")
+		bool bAlwaysRealtime = false;
+
+	//Max captured images alive between readback and import, bounds memory while workers encode and decode
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "1", ClampMax = "64", UIMin = "1", UIMax = "64"))
+		int32 MaxImagesInFlight = 8;
+
+	//Milliseconds the pipeline may spend per editor frame, 0 for no limit. Commandlets and unattended runs are never limited
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "0", UIMax = "33"))
+		float FrameBudgetMs = 8.f;
+
+	//Assets loaded asynchronously ahead of the one being captured
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "1", UIMin = "1", UIMax = "64"))
+		int32 PrefetchCount = 8;
+
+	//Seconds to wait for shaders, texture streaming and mesh builds before capturing anyway
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "0"))
+		float ReadinessTimeout = 10.f;
+
+	//Imported thumbnails saved together, 0 leaves them dirty for a manual save
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "0", UIMax = "256"))
+		int32 SaveGroupSize = 16;
+
+	//Used physical memory in MB above which saved thumbnails and captured assets are released and garbage is collected, 0 never collects
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "0"))
+		int32 MemoryHighWaterMB = 0;
+
+	//Capture queued assets through the tab viewport or a pool of offscreen scenes, current view shots always use the viewport
+	UPROPERTY(EditAnywhere, Category = "Performance")
+		EThumbnailCaptureBackend CaptureBackend = EThumbnailCaptureBackend::Viewport;
+
+	//Offscreen scenes capturing at the same time
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "CaptureBackend != EThumbnailCaptureBackend::Viewport"))
+		int32 CaptureSceneCount = 4;
+
+	//Scene pool captures the gpu may still be copying back while new ones are rendered
+	UPROPERTY(EditAnywhere, Category = "Performance", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "CaptureBackend == EThumbnailCaptureBackend::ScenePool"))
+		int32 ReadbacksInFlight = 3;
+
+	//Quality per output size, the profile with the smallest Max Size that fits the output is used
+	UPROPERTY(EditAnywhere, Category = "Quality")
+		TArray<FThumbnailCaptureProfile> CaptureProfiles;
+
+	//Crop every capture to the opaque pixels and scale it back up to the output size, long and thin assets fill the thumbnail instead of floating in empty space
+	UPROPERTY(EditAnywhere, Category = "Quality")
+		bool bAutoCrop = false;
+
+	//Empty border around the cropped asset, as a fraction of the output size
+	UPROPERTY(EditAnywhere, Category = "Quality", meta = (ClampMin = "0", ClampMax = "0.4", EditCondition = "bAutoCrop"))
+		float AutoCropPadding = 0.05f;
+
+	//Pixels with an alpha above this count as part of the asset, raise it if soft shadows or fog widen the crop
+	UPROPERTY(EditAnywhere, Category = "Quality", meta = (ClampMin = "0", ClampMax = "254", EditCondition = "bAutoCrop"))
+		int32 AutoCropAlphaThreshold = 8;
+
+	UThumbnailOptions();
+
+	//Profile for the current screenshot size, full quality if none fits
+	const FThumbnailCaptureProfile& GetCaptureProfile() const;
+
 };
@@ -0,0 +1,95 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StreamableManager.h"
+
+//Kind of asset a thumbnail can be taken of
+enum class EThumbnailAssetType : uint8
+{
+	Unsupported,
+	StaticMesh,
+	SkeletalMesh,
+	Animation,
+	Material
+};
+
+//Queued asset together with its type and the load that keeps it alive
+struct FThumbnailPrefetchedAsset
+{
+	FAssetData Data;
+	EThumbnailAssetType Type = EThumbnailAssetType::Unsupported;
+	//Async load of the asset, holds the loaded asset until released
+	TSharedPtr<FStreamableHandle> Handle;
+	//Was the package already in memory before the load was started? Only packages we loaded ourselves are unloaded again
+	bool bWasLoaded = false;
+	//Time the load was requested
+	double RequestTime = 0.0;
+
+	//Loaded asset, only valid once the load finished
+	UObject* GetAsset() const;
+};
+
+/*
+*	Loads queued assets asynchronously ahead of the capture stage.
+*	Assets come out in the order they were queued, the capture stage never waits on a synchronous load.
+*/
+class THUMBNAILCREATOR_API FThumbnailAssetPrefetcher
+{
+public:
+
+	/*
+	*	Resolve the thumbnail type from the asset class path without loading the asset
+	*
+	*	@param	Data		Asset to resolve
+	*/
+	static EThumbnailAssetType ResolveAssetType(const FAssetData& Data);
+
+	/*
+	*	Queue an asset for loading, unsupported types are dropped right away
+	*
+	*	@param	Data		Asset to queue
+	*	@return	true if the asset was queued
+	*/
+	bool Enqueue(const FAssetData& Data);
+
+	/*
+	*	Start async loads until LookAhead assets are loading or loaded
+	*
+	*	@param	LookAhead	Max assets to keep loading or loaded ahead of the capture stage
+	*	@param	OnLoaded	Called on the game thread whenever a load finishes
+	*/
+	void Update(int32 LookAhead, FSimpleDelegate OnLoaded);
+
+	/*
+	*	Take the next asset out if its load finished
+	*
+	*	@param	OutAsset	Loaded asset
+	*	@return	false if the queue is empty or the next asset is still loading
+	*/
+	bool PopLoaded(FThumbnailPrefetchedAsset& OutAsset);
+
+	//Drop all queued assets and cancel their loads
+	void Empty();
+
+	//Amount of assets queued, loading or loaded
+	int32 Num() const { return NumQueued + NumRequested; }
+
+	//Amount of assets with a load started
+	int32 NumLoading() const { return NumRequested; }
+
+private:
+
+	FStreamableManager StreamableManager;
+
+	//Assets without a load started yet
+	TQueue<FThumbnailPrefetchedAsset> Queued;
+	int32 NumQueued = 0;
+
+	//Assets with a load started, in queue order
+	TQueue<FThumbnailPrefetchedAsset> Requested;
+	int32 NumRequested = 0;
+};
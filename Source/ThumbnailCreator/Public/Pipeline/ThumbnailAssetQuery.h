@@ -0,0 +1,50 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/ARFilter.h"
+
+struct FAssetData;
+
+/*
+*	Asset registry query that hands out its results in pages of a folder.
+*	Only the folder names are gathered up front and large folders are split into pages, so a query matching a whole project never holds all of its FAssetData at once.
+*/
+class THUMBNAILCREATOR_API FThumbnailAssetQuery
+{
+public:
+
+	/*
+	*	Create the query
+	*
+	*	@param	InFilter	Paths, classes and tags to match, recursive paths are split into their sub folders
+	*/
+	FThumbnailAssetQuery(const FARFilter& InFilter);
+
+	/*
+	*	Get the next page of matching assets, the rest of a large folder is left for the next pages
+	*
+	*	@param	OutAssets	Assets of the page, emptied first, at most PageSize
+	*	@return	false once every folder was visited
+	*/
+	bool NextPage(TArray<FAssetData>& OutAssets);
+
+	//Folders that were not queried yet
+	int32 GetNumFoldersLeft() const { return Folders.Num() - NextFolder; }
+
+	//Max assets handed out per page
+	static constexpr int32 PageSize = 256;
+
+private:
+
+	//Filter of a single folder, the path is swapped for every page
+	FARFilter Filter;
+
+	//Every folder to query, without recursion
+	TArray<FName> Folders;
+	int32 NextFolder = 0;
+
+	//Assets of the folder in front of NextFolder that were already handed out, 0 once it is done
+	int32 FolderCursor = 0;
+};
@@ -0,0 +1,89 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class UThumbnailOptions;
+
+/*
+*	Remembers which saved asset and options every thumbnail was generated from, kept in Saved between sessions.
+*	Assets whose key still matches and whose thumbnail texture still exists don't have to be captured again.
+*/
+class THUMBNAILCREATOR_API FThumbnailCache
+{
+public:
+
+	~FThumbnailCache();
+
+	/*
+	*	Hash every option that changes the captured image
+	*	Options added later that change the image have to be added here, otherwise their thumbnails are skipped
+	*
+	*	@param	Options			Options to capture with
+	*	@param	ProfileIndex	Preview scene profile the asset is lit with
+	*	@param	ManualView		Camera of the viewport every backend shoots from without auto size, null if there is none and assets are framed by the options
+	*/
+	static uint64 HashOptions(const UThumbnailOptions& Options, int32 ProfileIndex, const struct FThumbnailCaptureView* ManualView);
+
+	/*
+	*	Make the key of an asset from the registry, without loading it
+	*
+	*	@param	Data			Asset to make the key for
+	*	@param	OptionsHash		Hash of the options from HashOptions
+	*	@return	Key, 0 if the asset has unsaved changes or was never saved
+	*/
+	static uint64 MakeKey(const FAssetData& Data, uint64 OptionsHash);
+
+	/*
+	*	Was the thumbnail of this asset generated with the same key and do it and its extra sizes still exist?
+	*
+	*	@param	Data			Asset to check
+	*	@param	Key				Key from MakeKey
+	*	@param	Options			Options the key was made with, for the extra output sizes
+	*/
+	bool IsUpToDate(const FAssetData& Data, uint64 Key, const UThumbnailOptions& Options);
+
+	/*
+	*	Does a texture exist in memory or on disk?
+	*
+	*	@param	TextureName		Name of the texture in the export folder
+	*/
+	static bool DoesTextureExist(const FString& TextureName);
+
+	/*
+	*	Remember the key an asset was generated with
+	*
+	*	@param	AssetPath		Object path of the source asset
+	*	@param	Key				Key from MakeKey, 0 is not remembered
+	*	@param	TextureName		Name of the thumbnail texture
+	*/
+	void Record(const FString& AssetPath, uint64 Key, const FString& TextureName);
+
+	//Write the cache to Saved if anything changed since it was loaded
+	void Flush();
+
+private:
+
+	//Read the cache from Saved the first time it is needed
+	void Load();
+
+	//Key and thumbnail of a source asset
+	struct FRecord
+	{
+		uint64 Key = 0;
+		FString TextureName;
+
+		friend FArchive& operator<<(FArchive& Ar, FRecord& Record)
+		{
+			return Ar << Record.Key << Record.TextureName;
+		}
+	};
+
+	//Records by object path of the source asset
+	TMap<FString, FRecord> Records;
+
+	bool bLoaded = false;
+	bool bDirty = false;
+};
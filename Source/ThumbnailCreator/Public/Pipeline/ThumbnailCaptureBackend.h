@@ -0,0 +1,99 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pipeline/ThumbnailImage.h"
+
+class UPrimitiveComponent;
+class UThumbnailOptions;
+enum class EThumbnailAssetType : uint8;
+
+/*
+*	Called when a slot finished capturing
+*
+*	@param	Slot		Slot of the backend the image was captured in
+*	@param	Image		Captured pixels, empty if the capture failed
+*/
+DECLARE_DELEGATE_TwoParams(FOnThumbnailCaptured, int32 /*Slot*/, FThumbnailImage& /*Image*/);
+
+//Fixed camera for shots taken without auto size, the one the viewport was left at
+struct FThumbnailCaptureView
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float FOV = 90.f;
+};
+
+/*
+*	Something that can render assets into images for the pipeline.
+*	A backend has one or more slots, every slot shows one asset at a time and captures it independently.
+*/
+class THUMBNAILCREATOR_API IThumbnailCaptureBackend
+{
+public:
+
+	virtual ~IThumbnailCaptureBackend() {}
+
+	//Amount of assets that can be captured at the same time
+	virtual int32 GetNumSlots() const = 0;
+
+	//Can the backend capture right now?
+	virtual bool IsAvailable() const { return true; }
+
+	//Is a slot free for the next asset as soon as Capture returned? Its image is then reported on a later frame
+	virtual bool IsPipelined() const { return false; }
+
+	/*
+	*	Can another capture be started without waiting on older readbacks?
+	*
+	*	@param	Options		Options to capture with
+	*/
+	virtual bool CanBeginCapture(const UThumbnailOptions& Options) const { return true; }
+
+	/*
+	*	Report captures whose pixels arrived since the last poll through OnCaptured
+	*
+	*	@return	true if any capture was reported
+	*/
+	virtual bool PollReadbacks() { return false; }
+
+	//Amount of captures waiting on their pixels
+	virtual int32 GetNumPendingReadbacks() const { return 0; }
+
+	/*
+	*	Show an asset in a slot
+	*
+	*	@param	Slot		Slot to show the asset in
+	*	@param	Asset		Loaded asset
+	*	@param	Type		Type the asset was resolved to
+	*	@param	Options		Options to capture with
+	*	@return	true if the asset can be captured
+	*/
+	virtual bool AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options) = 0;
+
+	/*
+	*	Get the component showing the asset of a slot
+	*
+	*	@param	Slot		Slot to query
+	*/
+	virtual UPrimitiveComponent* GetActiveComponent(int32 Slot) const = 0;
+
+	/*
+	*	Capture the asset shown in a slot, the result is reported through OnCaptured
+	*
+	*	@param	Slot		Slot to capture
+	*	@param	Options		Options to capture with
+	*/
+	virtual void Capture(int32 Slot, const UThumbnailOptions& Options) = 0;
+
+	/*
+	*	Camera for the next captures instead of orbiting the asset, backends that frame by themselves ignore it
+	*
+	*	@param	View		Camera to use, unset to frame the asset by the options
+	*/
+	virtual void SetManualView(const TOptional<FThumbnailCaptureView>& View) {}
+
+	//Fired for every finished capture
+	FOnThumbnailCaptured OnCaptured;
+};
@@ -0,0 +1,89 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Pipeline/ThumbnailImage.h"
+#include "Pipeline/ThumbnailGPUReadback.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+
+class FAdvancedPreviewScene;
+class UStaticMeshComponent;
+class USkeletalMeshComponent;
+class UPostProcessComponent;
+class USceneCaptureComponent2D;
+class UTextureRenderTarget2D;
+class UPrimitiveComponent;
+class UThumbnailOptions;
+enum class EThumbnailAssetType : uint8;
+
+/*
+*	Offscreen preview scene with its own components and scene capture.
+*	Mirrors the setup of the tab viewport so captures look the same, but renders into a render target.
+*	Pixels come back through a non blocking readback, so the render target is free for the next asset as soon as the copy is queued.
+*	The final color of a scene capture has no alpha without a project setting, so a cheap unlit scene color pass provides the mask instead.
+*/
+class THUMBNAILCREATOR_API FThumbnailCaptureScene : public FGCObject
+{
+public:
+
+	/*
+	*	Create the scene
+	*
+	*	@param	ProfileIndex	Preview scene profile to light the scene with
+	*/
+	FThumbnailCaptureScene(int32 ProfileIndex);
+	virtual ~FThumbnailCaptureScene();
+
+	/*
+	*	Show an asset, hides the components of the other types
+	*
+	*	@param	Asset		Loaded asset
+	*	@param	Type		Type the asset was resolved to
+	*	@param	Options		Options to pick the capture profile from
+	*	@return	true if the asset can be captured
+	*/
+	bool SetAsset(UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options);
+
+	/*
+	*	Render the shown asset and start reading the pixels back, the scene can show the next asset right away
+	*
+	*	@param	Options		Size and camera to capture with
+	*	@param	ManualView	Camera to shoot from instead of orbiting the asset, same as the viewport without auto size
+	*	@return	Readback to poll for the image, null if nothing could be captured
+	*/
+	TUniquePtr<FThumbnailGPUReadback> Capture(const UThumbnailOptions& Options, const TOptional<FThumbnailCaptureView>& ManualView);
+
+	//Component showing the asset
+	UPrimitiveComponent* GetActiveComponent() const { return ActiveComp; }
+
+	//Name of the shown asset
+	FString GetAssetName() const;
+
+	//FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FThumbnailCaptureScene"); }
+
+private:
+
+	//Orbit the capture around the active component or use the manual view, same framing as the viewport
+	void UpdateCaptureTransform(const UThumbnailOptions& Options, const TOptional<FThumbnailCaptureView>& ManualView);
+
+	TUniquePtr<FAdvancedPreviewScene> PreviewScene;
+
+	//All components to use in the scene
+	TObjectPtr<UStaticMeshComponent> MeshComp;
+	TObjectPtr<USkeletalMeshComponent> SkelMeshComp;
+	TObjectPtr<UStaticMeshComponent> MaterialComp;
+	TObjectPtr<UPostProcessComponent> PostComp;
+	TObjectPtr<USceneCaptureComponent2D> CaptureComp;
+	TObjectPtr<UTextureRenderTarget2D> RenderTarget;
+	//Second capture of the same view, its scene color alpha is the inverse opacity of the asset
+	TObjectPtr<USceneCaptureComponent2D> MaskCaptureComp;
+	TObjectPtr<UTextureRenderTarget2D> MaskTarget;
+
+	//Component of the shown asset and the asset itself
+	TObjectPtr<UPrimitiveComponent> ActiveComp;
+	TObjectPtr<UObject> ActiveAsset;
+};
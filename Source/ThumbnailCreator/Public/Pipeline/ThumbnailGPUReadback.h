@@ -0,0 +1,52 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pipeline/ThumbnailImage.h"
+
+class FTextureRenderTargetResource;
+
+/*
+*	Non blocking copy of a render target back to the cpu.
+*	The copy is queued on the render thread behind the capture, the game thread polls it on later frames instead of flushing.
+*	An optional mask target is read back alongside and replaces the alpha of the color, for captures whose final color has no usable alpha.
+*/
+class THUMBNAILCREATOR_API FThumbnailGPUReadback
+{
+public:
+
+	/*
+	*	Queue the copy of a render target, must be called right after the capture was enqueued
+	*
+	*	@param	Resource	Render target resource the capture renders into
+	*	@param	InImage		Name and size of the image, pixels are filled in once the copy finished
+	*	@param	MaskResource	Half float render target with the inverse opacity in alpha, same size as Resource, null to keep the alpha of the color
+	*/
+	FThumbnailGPUReadback(FTextureRenderTargetResource* Resource, FThumbnailImage&& InImage, FTextureRenderTargetResource* MaskResource = nullptr);
+
+	/*
+	*	Poll the copy
+	*
+	*	@param	OutImage	Finished image, only set when true is returned
+	*	@return	true once the pixels are on the cpu
+	*/
+	bool Poll(FThumbnailImage& OutImage);
+
+private:
+
+	//Shared with the render thread, outlives the readback if the owner goes away first
+	struct FState
+	{
+		TUniquePtr<class FRHIGPUTextureReadback> Readback;
+		//Copy of the mask target, null without a mask
+		TUniquePtr<class FRHIGPUTextureReadback> MaskReadback;
+		FThumbnailImage Image;
+		//Lock and copy was requested on the render thread
+		bool bCopyRequested = false;
+		//Pixels were copied out of the staging buffer
+		TAtomic<bool> bCopied { false };
+	};
+
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+};
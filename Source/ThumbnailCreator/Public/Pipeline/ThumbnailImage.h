@@ -0,0 +1,68 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//Seconds an image spent in each stage, for benchmarks
+struct FThumbnailTimings
+{
+	//Time the load of the asset was requested, 0 for images not captured from a queued asset
+	double Begin = 0.0;
+	//Time the current stage was entered
+	double StageStart = 0.0;
+	//Load requested until a slot took the asset
+	double Load = 0.0;
+	//Assigned until the asset was ready to render
+	double Ready = 0.0;
+	//Shot requested until the pixels were read back
+	double Capture = 0.0;
+	//Read back until a worker finished the png encode or decode
+	double Process = 0.0;
+	//Processed until the texture was imported
+	double Import = 0.0;
+
+	//Store the time since the current stage started in Stage and start the next one
+	void EndStage(double& Stage)
+	{
+		const double Now = FPlatformTime::Seconds();
+		Stage = Now - StageStart;
+		StageStart = Now;
+	}
+};
+
+//Smaller copy of a thumbnail, reduced from the capture instead of rendered again
+struct FThumbnailOutput
+{
+	//Name of the asset to create, without path
+	FString AssetName;
+	//Dimensions of Pixels
+	FIntPoint Size = FIntPoint::ZeroValue;
+	//BGRA pixels
+	TArray<FColor> Pixels;
+};
+
+//Captured image travelling from the capture stage to the import stage
+struct FThumbnailImage
+{
+	//Name of the asset to create, without path
+	FString AssetName;
+	//Png to decode the pixels from, empty for captures read back from the viewport
+	FString SourceFile;
+	//Png to write a copy of the pixels to, empty to keep the image in memory only
+	FString ExportFile;
+	//Dimensions of Pixels
+	FIntPoint Size = FIntPoint::ZeroValue;
+	//BGRA pixels, read straight back from the viewport or decoded from SourceFile
+	TArray<FColor> Pixels;
+	//Factor the pixels are larger than the output along each axis, a worker filters them down
+	int32 Supersample = 1;
+	//Object path of the captured asset, empty for current view shots and images found on disk
+	FString SourceAsset;
+	//Cache key the asset was captured with, 0 if it can't be cached
+	uint64 CacheKey = 0;
+	//Time spent in every stage so far
+	FThumbnailTimings Timings;
+	//Smaller copies filled in by the worker, each imported as its own texture
+	TArray<FThumbnailOutput> ExtraOutputs;
+};
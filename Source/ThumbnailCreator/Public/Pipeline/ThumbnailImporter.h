@@ -0,0 +1,46 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FThumbnailImage;
+
+/*
+*	Creates or updates thumbnail textures from decoded pixels.
+*	The pixels become the texture source directly, there is no factory and no second decode.
+*/
+class THUMBNAILCREATOR_API FThumbnailImporter
+{
+public:
+
+	//Content folder all thumbnails are exported to
+	static const TCHAR* ExportPath;
+
+	/*
+	*	Write the image into its Thumb_ texture, creating the package if it doesn't exist yet
+	*	An existing texture whose source matches the image within the tolerance is left untouched
+	*
+	*	@param	Image				Decoded BGRA image to import
+	*	@param	Tolerance			Max difference of any channel of any pixel that still counts as unchanged
+	*	@param	bOutExistingAsset	Set to true if an existing texture was updated
+	*	@param	bOutUnchanged		Set to true if the existing texture already had these pixels and wasn't touched
+	*	@return	the imported texture or nullptr on failure
+	*/
+	static class UTexture2D* ImportTexture(const FThumbnailImage& Image, int32 Tolerance, bool& bOutExistingAsset, bool& bOutUnchanged);
+
+	/*
+	*	Compare two BGRA buffers of the same size
+	*
+	*	@param	A			First buffer
+	*	@param	B			Second buffer
+	*	@param	NumBytes	Size of both buffers
+	*	@param	Tolerance	Max difference of any channel that still counts as equal, 0 for byte identical
+	*/
+	static bool ArePixelsEqual(const uint8* A, const uint8* B, int64 NumBytes, int32 Tolerance);
+
+private:
+
+	//Does the source of an existing texture already hold the image?
+	static bool IsSourceUnchanged(class UTexture2D* Texture, const FThumbnailImage& Image, int32 Tolerance);
+};
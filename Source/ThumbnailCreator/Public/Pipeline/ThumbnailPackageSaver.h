@@ -0,0 +1,92 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UPackage;
+
+/*
+*	Collects finished thumbnail packages and saves them in groups.
+*	Packages are serialized on the game thread one at a time and written to disk in the background, so saving overlaps with further captures.
+*	Saved packages that were not in memory before the batch can be unloaded again, so long batches don't keep every texture alive.
+*	In the editor files are checked out before they are saved and new ones are marked for add once they are written, commandlets save straight to disk.
+*/
+class THUMBNAILCREATOR_API FThumbnailPackageSaver
+{
+public:
+
+	/*
+	*	Queue a package for the next group
+	*
+	*	@param	Package			Dirty thumbnail package
+	*	@param	bWasLoaded		Was the package in memory before the pipeline touched it?
+	*/
+	void Add(UPackage* Package, bool bWasLoaded);
+
+	/*
+	*	Remember a source package the pipeline loaded itself, it can be unloaded once it was captured
+	*
+	*	@param	Package		Package of the captured asset
+	*/
+	void AddUnloadCandidate(UPackage* Package);
+
+	/*
+	*	Only remember unload candidates while something releases them, turning it off forgets the ones collected so far
+	*
+	*	@param	bInTrackUnloads		Is a memory high water mark set?
+	*/
+	void SetTrackUnloads(bool bInTrackUnloads);
+
+	/*
+	*	Save the oldest queued package, the file is written asynchronously
+	*
+	*	@return	true if the package was saved
+	*/
+	bool SaveNext();
+
+	/*
+	*	Save every queued package
+	*
+	*	@return	Amount of packages saved
+	*/
+	int32 SaveGroup();
+
+	//Block until every asynchronous package write finished and mark new files for add
+	void FinishWrites();
+
+	/*
+	*	Get the packages that failed to save since the last call, a notification is shown in the editor if there were any
+	*
+	*	@return	Amount of failed saves
+	*/
+	int32 TakeNumFailed();
+
+	/*
+	*	Drop the standalone flag of clean packages the pipeline loaded, the next garbage collection frees them
+	*
+	*	@return	Amount of packages released
+	*/
+	int32 ReleaseUnloadCandidates();
+
+	//Amount of packages waiting for the next group
+	int32 Num() const { return NumPending; }
+
+private:
+
+	//Dirty packages waiting to be saved, with whether they were in memory before, oldest first
+	TQueue<TPair<TWeakObjectPtr<UPackage>, bool>> Pending;
+	int32 NumPending = 0;
+
+	//Saved thumbnails and captured sources that only we loaded
+	TArray<TWeakObjectPtr<UPackage>> UnloadCandidates;
+	//Are unload candidates collected?
+	bool bTrackUnloads = false;
+
+	//Files saved for the first time, marked for add once their write finished
+	TArray<FString> NewFiles;
+	//Saves that failed since the last TakeNumFailed
+	int32 NumFailed = 0;
+};
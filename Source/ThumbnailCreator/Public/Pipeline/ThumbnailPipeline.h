@@ -0,0 +1,387 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "AssetRegistry/AssetData.h"
+#include "Pipeline/ThumbnailImage.h"
+#include "Pipeline/ThumbnailAssetPrefetcher.h"
+#include "Pipeline/ThumbnailReadiness.h"
+#include "Pipeline/ThumbnailCache.h"
+#include "Pipeline/ThumbnailAssetQuery.h"
+#include "Pipeline/ThumbnailPackageSaver.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+#include "Objects/ThumbnailOptions.h"
+
+class FThumbnailCreatorModule;
+
+//Stages every thumbnail passes through, in order
+enum class EThumbnailStage : uint8
+{
+	Assign,
+	Ready,
+	Capture,
+	Readback,
+	Decode,
+	Import,
+	Save,
+	Num
+};
+
+/*
+*	Fixed capacity FIFO between two pipeline stages.
+*	Pushing fails once the queue is full so the producing stage stalls instead of piling up work.
+*/
+template<typename ItemType>
+class TThumbnailStageQueue
+{
+public:
+	explicit TThumbnailStageQueue(int32 InCapacity)
+		: Capacity(InCapacity)
+	{
+	}
+
+	bool Push(ItemType&& Item)
+	{
+		if (IsFull())
+		{
+			return false;
+		}
+		Items.Enqueue(MoveTemp(Item));
+		++Count;
+		return true;
+	}
+
+	bool Pop(ItemType& OutItem)
+	{
+		if (!Items.Dequeue(OutItem))
+		{
+			return false;
+		}
+		--Count;
+		return true;
+	}
+
+	void Empty()
+	{
+		Items.Empty();
+		Count = 0;
+	}
+
+	bool IsFull() const { return Count >= Capacity; }
+	bool IsEmpty() const { return Count == 0; }
+	int32 Num() const { return Count; }
+
+private:
+	TQueue<ItemType> Items;
+	int32 Count = 0;
+	int32 Capacity;
+};
+
+//Counters since the pipeline was created
+struct FThumbnailPipelineStats
+{
+	//Assets queued for capture
+	int32 Queued = 0;
+	//Assets dropped because their thumbnail was up to date
+	int32 Skipped = 0;
+	//Assets dropped because their type has no thumbnail
+	int32 Unsupported = 0;
+	//Textures written or found unchanged
+	int32 Imported = 0;
+	//Imported textures whose pixels were the same as before
+	int32 Unchanged = 0;
+	//Assets or images that failed to load, capture, decode or import
+	int32 Failed = 0;
+	//Thumbnail packages saved
+	int32 Saved = 0;
+	//Garbage collections run because memory went over the high water mark
+	int32 Collections = 0;
+	//Highest used physical memory seen while work was running
+	uint64 PeakUsedPhysical = 0;
+};
+
+//Asset an image was captured from, for the cache
+struct FThumbnailCaptureSource
+{
+	FString AssetPath;
+	uint64 CacheKey = 0;
+	FThumbnailTimings Timings;
+};
+
+//Options the worker side needs, copied on the game thread for every image
+struct FThumbnailProcessSettings
+{
+	//Largest sides of the smaller copies to build
+	TArray<int32> OutputSizes;
+	//Crop to the opaque pixels before filtering
+	bool bAutoCrop = false;
+	//Border around the crop as a fraction of the output size
+	float AutoCropPadding = 0.f;
+	//Alpha above which a pixel counts as opaque
+	uint8 AutoCropAlphaThreshold = 0;
+};
+
+//Broadcast for every imported thumbnail, with the time it spent in each stage
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnThumbnailImported, const FThumbnailImage&);
+
+//A slot of a capture backend as seen by the pipeline
+struct FThumbnailCaptureSlot
+{
+	//Backend owning the slot
+	class IThumbnailCaptureBackend* Backend = nullptr;
+	//Index of the slot in its backend
+	int32 Index = 0;
+	//Waits on shaders, textures and mesh data of the assigned asset before the shot is requested
+	FThumbnailReadiness Readiness;
+	//Is an asset assigned that was not captured yet?
+	bool bAssigned = false;
+	//Is an asset assigned or a shot requested and not yet read back?
+	bool bBusy = false;
+	//Asset currently assigned to the slot
+	FThumbnailCaptureSource Assigned;
+	//Assets captured in the slot and not yet read back, oldest first
+	TArray<FThumbnailCaptureSource> Captured;
+};
+
+/*
+*	Event driven capture -> import pipeline.
+*	Every stage is started by the completion of the stage in front of it, there is no polling timer.
+*	A single game thread pump is scheduled whenever an event arrives and runs every stage that can make progress.
+*	Queued assets are spread over all slots of the capture backend, so several captures can be in flight.
+*	Png encoding and decoding run on worker tasks, only UObject work stays on the game thread.
+*/
+class THUMBNAILCREATOR_API FThumbnailPipeline : public TSharedFromThis<FThumbnailPipeline>
+{
+public:
+
+	FThumbnailPipeline(FThumbnailCreatorModule& InModule);
+	~FThumbnailPipeline();
+
+	/*
+	*	Add assets to the back of the capture queue
+	*
+	*	@param	Assets		Assets to generate thumbnails for
+	*/
+	void EnqueueAssets(const TArray<FAssetData>& Assets);
+
+	/*
+	*	Queue every asset matching an asset registry filter, results are fetched a folder at a time as the queue drains
+	*
+	*	@param	Filter		Paths, classes and tags to match
+	*/
+	void EnqueueQuery(const FARFilter& Filter);
+
+	//Capture the viewport as it currently is, without assigning an asset
+	void EnqueueCurrentView();
+
+	//Backend capturing through the tab viewport, the viewport client reports its readbacks here
+	class FThumbnailViewportCaptureBackend& GetViewportBackend() const { return *ViewportBackend; }
+
+	//Drop all queued work
+	void Cancel();
+
+	/*
+	*	Called when the tab opens or closes, shots waiting on a closed viewport are failed
+	*
+	*	@param	bAvailable	Is the tab open?
+	*/
+	void SetViewportAvailable(bool bAvailable);
+
+	//Are all stages empty?
+	bool IsIdle() const;
+
+	/*
+	*	Get the amount of items waiting in front of a stage
+	*
+	*	@param	Stage		Stage to query
+	*/
+	int32 GetStageDepth(EThumbnailStage Stage) const;
+
+	//Amount of captured images alive between readback and import
+	int32 GetImagesInFlight() const { return NumImagesInFlight; }
+
+	//Is an asset waiting in the tab viewport or a shot of it requested?
+	bool IsViewportBusy() const;
+
+	//Folders of running asset registry queries that were not fetched yet
+	int32 GetNumFoldersLeft() const;
+
+	//Counters since the pipeline was created or the last reset
+	const FThumbnailPipelineStats& GetStats() const { return Stats; }
+
+	//Start counting from zero
+	void ResetStats() { Stats = FThumbnailPipelineStats(); }
+
+	//Called on the game thread once a thumbnail was imported
+	FOnThumbnailImported OnImported;
+
+	//Called when work arrives while the pipeline is idle
+	FSimpleMulticastDelegate OnBatchStarted;
+
+	//Called from the pump once every stage is empty and idle resources were released, the pipeline may be destroyed on a later frame
+	FSimpleMulticastDelegate OnIdle;
+
+private:
+
+	//Schedule a pump on the next game thread frame if none is scheduled yet
+	void Kick();
+
+	//Run every stage that can make progress within the frame budget, returns false so the one shot ticker is removed
+	bool Pump(float Delta);
+
+	//Create the backend the options ask for and lay out the slots, only while no capture is running
+	void UpdateBackends();
+	//Rebuild the slots from the backends that exist
+	void LayoutSlots();
+	//Free the offscreen scenes and write the cache once a batch is done
+	void ReleaseIdleResources();
+	//Start counting a new batch if nothing is running, call before queuing the work
+	void BeginBatch();
+
+	//Queue assets without starting a new batch, up to date and unsupported assets are dropped
+	void QueueAssets(const TArray<FAssetData>& Assets);
+	//Queue the next page of the running queries once the queue runs low
+	bool RefillFromQueries();
+	//Assign the next asset to every free slot and request shots of assets that are ready to render
+	bool RunCaptureStage();
+	//Advance a single capture slot
+	bool RunCaptureSlot(FThumbnailCaptureSlot& Slot);
+	//Pick up images that showed up in the screenshot folder
+	bool RunReadbackStage();
+	//Directory watcher notification for the screenshot folder
+	void OnDirectoryChanged(const TArray<struct FFileChangeData>& Changes);
+	//Hand the next captured image to a worker for png encoding or decoding
+	bool RunDecodeStage();
+	//Create the texture asset for the next processed image
+	bool RunImportStage();
+	//Flag the package of an imported texture for saving and save it with its group
+	void RunSaveStage(class UTexture2D* Texture, class UPackage* Package, bool bExistingAsset, bool bWasLoaded);
+	/*
+	*	Import one texture of an image and queue it for saving
+	*
+	*	@param	Image			Image to import
+	*	@param	bOutUnchanged	Set to true if the texture already had these pixels
+	*	@return	true if the texture was imported
+	*/
+	bool ImportImage(const FThumbnailImage& Image, bool& bOutUnchanged);
+	//Save one package of a full group, returns true if there was one
+	bool RunPackageSaveStage();
+	//Save the queued group of thumbnail packages if saving is on
+	void SavePendingPackages();
+	//Track peak memory and release saved packages and captured assets above the high water mark
+	void UpdateMemory();
+	//Publish queue depths and images in flight to the stats group
+	void UpdateStatCounters() const;
+	//Tell the viewport client when viewport work starts or stops, so it only renders realtime meanwhile
+	void UpdateViewportRealtime();
+
+	/*
+	*	Called by a backend once a slot finished capturing
+	*
+	*	@param	Slot		Slot of the backend
+	*	@param	Image		Captured pixels, empty if the capture failed
+	*	@param	Backend		Backend that captured
+	*/
+	void OnCaptureReadback(int32 Slot, FThumbnailImage& Image, class IThumbnailCaptureBackend* Backend);
+
+	/*
+	*	Worker side of the decode stage, decodes SourceFile, crops, filters supersampled pixels, builds the smaller outputs and writes ExportFile
+	*
+	*	@param	Image		Image to process in place
+	*	@param	Settings	Options captured when the image was handed to the worker
+	*	@return	true if the image has valid pixels afterwards
+	*/
+	static bool ProcessImage(FThumbnailImage& Image, const FThumbnailProcessSettings& Settings);
+
+	//Max images alive between readback and import from the options
+	int32 GetMaxImagesInFlight() const;
+	//Max assets loaded ahead of the capture stage from the options
+	int32 GetPrefetchCount() const;
+	//Time a pump may spend per frame, 0 for no limit
+	double GetFrameBudgetSeconds() const;
+	//Preview scene profile assets are lit with
+	int32 GetProfileIndex() const;
+	//Hash of the current options for the cache
+	uint64 GetOptionsHash() const;
+	//Camera of the viewport while auto size is off, offscreen backends shoot from it too
+	TOptional<FThumbnailCaptureView> GetManualView() const;
+
+	//Is a slot free to take a new capture?
+	bool CanStartCapture() const;
+
+	FThumbnailCreatorModule& Module;
+
+	//Assets still waiting to be captured, loaded ahead of the capture stage
+	FThumbnailAssetPrefetcher Prefetcher;
+
+	//Registry queries that still have folders left, oldest first
+	TArray<TUniquePtr<FThumbnailAssetQuery>> Queries;
+
+	//Keys of generated thumbnails, unchanged assets are skipped
+	FThumbnailCache Cache;
+
+	//Current view shots waiting to be captured
+	int32 NumPendingViewShots = 0;
+
+	//Captures through the tab viewport, also used for current view shots
+	TUniquePtr<class FThumbnailViewportCaptureBackend> ViewportBackend;
+	//Scene pool or synthetic backend, only created when the options ask for one and assets are queued
+	TUniquePtr<class IThumbnailCaptureBackend> OffscreenBackend;
+	//Kind of backend OffscreenBackend is
+	EThumbnailCaptureBackend OffscreenBackendType = EThumbnailCaptureBackend::Viewport;
+	//Backend queued assets are captured with
+	class IThumbnailCaptureBackend* AssetBackend = nullptr;
+
+	//Slots of the viewport backend followed by the slots of the scene pool
+	TArray<FThumbnailCaptureSlot> Slots;
+
+	//Captured images waiting for a worker
+	TThumbnailStageQueue<FThumbnailImage> CapturedImages;
+	//Images finished by a worker waiting to be imported, filled from worker threads
+	TQueue<FThumbnailImage, EQueueMode::Mpsc> ProcessedImages;
+
+	//Full paths of pngs in the screenshot folder that were written or imported by the pipeline
+	TSet<FString> KnownImages;
+	//Pngs written by someone else, with the time of the last change notification
+	TMap<FString, double> NewImages;
+
+	//Watch of the screenshot folder, png files that show up there are imported
+	FDelegateHandle DirectoryWatcherHandle;
+	//Full path of the screenshot folder
+	FString WatchedPath;
+
+	//Worker tasks that may still be running
+	TArray<UE::Tasks::FTask> WorkerTasks;
+	//Images handed to a worker and not yet picked up by the import stage
+	int32 NumWorkerImages = 0;
+
+	//Images requested from a backend and not yet imported or dropped
+	int32 NumImagesInFlight = 0;
+
+	//Counters since the pipeline was created
+	FThumbnailPipelineStats Stats;
+	//Imported count at the last collection, so memory that stays high doesn't collect every frame
+	int32 ImportedAtLastCollection = 0;
+
+	//Saves finished thumbnails in groups and releases what the pipeline loaded
+	FThumbnailPackageSaver Saver;
+	//A full group is being saved, a package per round
+	bool bSavingGroup = false;
+
+	//Busy state the viewport client was last told about
+	bool bViewportRealtime = false;
+
+	//Time the current batch started, for the throughput log
+	double BatchStartTime = 0.0;
+	//Thumbnails imported in the current batch
+	int32 BatchImported = 0;
+	//Assets skipped in the current batch because they were up to date
+	int32 BatchSkipped = 0;
+
+	//Handle of the scheduled pump, valid while a pump is pending
+	FTSTicker::FDelegateHandle PumpHandle;
+};
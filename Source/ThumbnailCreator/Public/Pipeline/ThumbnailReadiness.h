@@ -0,0 +1,58 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UPrimitiveComponent;
+class UMaterialInterface;
+class UTexture2D;
+
+/*
+*	Waits until an assigned asset can be rendered the way it will look in the final thumbnail.
+*	Mesh render data, material shader maps and texture mips for the output size are polled until done or timed out.
+*/
+class THUMBNAILCREATOR_API FThumbnailReadiness
+{
+public:
+
+	/*
+	*	Start waiting on a component, forces the textures it uses to stream in
+	*
+	*	@param	Component			Component that will be captured
+	*	@param	TargetResolution	Largest side of the output image in pixels
+	*	@param	TimeoutSeconds		Give up waiting after this time and capture anyway
+	*/
+	void Begin(UPrimitiveComponent* Component, int32 TargetResolution, double TimeoutSeconds);
+
+	/*
+	*	Poll the wait
+	*
+	*	@param	bOutTimedOut	Set to true if the wait gave up before everything was ready
+	*	@return	true when the capture can be taken
+	*/
+	bool Poll(bool& bOutTimedOut);
+
+	//Forget the current wait
+	void Reset();
+
+	//Is a wait running?
+	bool IsWaiting() const { return Component.IsValid(); }
+
+private:
+
+	//Are the meshes render resources built and initialised?
+	bool IsMeshReady() const;
+	//Are all used materials done compiling for the current feature level?
+	bool AreMaterialsReady() const;
+	//Are enough mips resident for the target resolution?
+	bool AreTexturesReady() const;
+
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	TArray<TWeakObjectPtr<UMaterialInterface>> Materials;
+	TArray<TWeakObjectPtr<UTexture2D>> Textures;
+
+	int32 TargetResolution = 0;
+	double TimeoutTime = 0.0;
+};
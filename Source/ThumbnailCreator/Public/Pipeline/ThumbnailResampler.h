@@ -0,0 +1,86 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FThumbnailImage;
+
+/*
+*	Reduces captured images on worker threads.
+*	Filtering is alpha correct, colors are weighted by their alpha so transparent pixels around the stencil mask don't darken the edges.
+*/
+class THUMBNAILCREATOR_API FThumbnailResampler
+{
+public:
+
+	/*
+	*	Box filter the image down by an integer factor in place
+	*
+	*	@param	Image		Image to reduce, its size has to be a multiple of the factor
+	*	@param	Factor		Source pixels per output pixel along each axis
+	*	@return	false if the size is not a multiple of the factor, the image is left untouched then
+	*/
+	static bool Downsample(FThumbnailImage& Image, int32 Factor);
+
+	/*
+	*	Box filter pixels down by an integer factor
+	*
+	*	@param	Source		Source pixels
+	*	@param	SourceSize	Size of the source, a multiple of the factor
+	*	@param	Factor		Source pixels per output pixel along each axis
+	*	@param	Dest		Output pixels, SourceSize / Factor large
+	*/
+	static void BoxReduce(const FColor* Source, FIntPoint SourceSize, int32 Factor, FColor* Dest);
+
+	/*
+	*	Fill the extra outputs of an image, each one reduced from the smallest larger level that it divides, like a mip chain
+	*	Sizes are the largest side of the output, sizes that are not smaller than the image or don't divide it are skipped
+	*
+	*	@param	Image		Image at its final size, ExtraOutputs is filled as <AssetName>_<Size>
+	*	@param	Sizes		Largest sides of the outputs
+	*/
+	static void BuildExtraOutputs(FThumbnailImage& Image, const TArray<int32>& Sizes);
+
+	/*
+	*	Can BuildExtraOutputs make an output of this size from an image?
+	*
+	*	@param	ImageSize	Size of the image
+	*	@param	Size		Largest side of the output
+	*/
+	static bool CanReduceTo(FIntPoint ImageSize, int32 Size);
+
+	/*
+	*	Crop the image to its opaque pixels plus padding, keeping its aspect ratio, and scale the crop back up to the image size
+	*	The asset is centred, if it doesn't fit with the padding it is only centred and not scaled
+	*
+	*	@param	Image			Image to crop in place
+	*	@param	Padding			Empty border around the asset as a fraction of the image size
+	*	@param	AlphaThreshold	Alpha above which a pixel counts as opaque
+	*	@return	false if the image has no opaque pixels, it is left untouched then
+	*/
+	static bool AutoCrop(FThumbnailImage& Image, float Padding, uint8 AlphaThreshold);
+
+	/*
+	*	Find the rectangle around every pixel with an alpha above the threshold, four pixels per compare
+	*
+	*	@param	Source			Source pixels
+	*	@param	SourceSize		Size of the source
+	*	@param	AlphaThreshold	Alpha above which a pixel counts as opaque
+	*	@param	OutBounds		Opaque pixels, Max is exclusive
+	*	@return	false if no pixel is opaque
+	*/
+	static bool FindOpaqueBounds(const FColor* Source, FIntPoint SourceSize, uint8 AlphaThreshold, FIntRect& OutBounds);
+
+	/*
+	*	Bilinear sample a rectangle of the source into the destination, alpha correct, samples outside the source are transparent
+	*
+	*	@param	Source		Source pixels
+	*	@param	SourceSize	Size of the source
+	*	@param	Origin		Source position of the top left corner of the first destination pixel
+	*	@param	Step		Source pixels per destination pixel
+	*	@param	Dest		Output pixels
+	*	@param	DestSize	Size of the output
+	*/
+	static void Resample(const FColor* Source, FIntPoint SourceSize, FVector2f Origin, float Step, FColor* Dest, FIntPoint DestSize);
+};
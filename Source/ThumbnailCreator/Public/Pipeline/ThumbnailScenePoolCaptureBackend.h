@@ -0,0 +1,56 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+
+class FThumbnailCaptureScene;
+class FThumbnailGPUReadback;
+
+/*
+*	Captures through a pool of offscreen scenes, every scene is a slot.
+*	Works without the tab, so batches can capture several assets per frame.
+*	Readbacks are pipelined, a scene shows the next asset while the gpu still copies the previous one.
+*/
+class THUMBNAILCREATOR_API FThumbnailScenePoolCaptureBackend : public IThumbnailCaptureBackend
+{
+public:
+
+	/*
+	*	Create the pool
+	*
+	*	@param	NumScenes		Amount of scenes to create
+	*	@param	ProfileIndex	Preview scene profile to light the scenes with
+	*/
+	FThumbnailScenePoolCaptureBackend(int32 NumScenes, int32 ProfileIndex);
+	virtual ~FThumbnailScenePoolCaptureBackend();
+
+	//IThumbnailCaptureBackend
+	virtual int32 GetNumSlots() const override { return Scenes.Num(); }
+	virtual bool IsPipelined() const override { return true; }
+	virtual bool CanBeginCapture(const UThumbnailOptions& Options) const override;
+	virtual bool PollReadbacks() override;
+	virtual int32 GetNumPendingReadbacks() const override { return PendingReadbacks.Num(); }
+	virtual bool AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options) override;
+	virtual UPrimitiveComponent* GetActiveComponent(int32 Slot) const override;
+	virtual void Capture(int32 Slot, const UThumbnailOptions& Options) override;
+	virtual void SetManualView(const TOptional<FThumbnailCaptureView>& View) override { ManualView = View; }
+
+private:
+
+	//Capture still on its way back from the gpu
+	struct FPendingReadback
+	{
+		int32 Slot = 0;
+		TUniquePtr<FThumbnailGPUReadback> Readback;
+	};
+
+	TArray<TUniquePtr<FThumbnailCaptureScene>> Scenes;
+
+	//Oldest first
+	TArray<FPendingReadback> PendingReadbacks;
+
+	//Camera of the viewport while auto size is off
+	TOptional<FThumbnailCaptureView> ManualView;
+};
@@ -0,0 +1,40 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+
+/*
+*	Stand-in backend that fills images on the cpu instead of rendering.
+*	Lets build machines without a gpu run and benchmark every stage except the render itself.
+*/
+class THUMBNAILCREATOR_API FThumbnailSyntheticCaptureBackend : public IThumbnailCaptureBackend
+{
+public:
+
+	/*
+	*	Create the backend
+	*
+	*	@param	NumSlots	Amount of assets that can be assigned at the same time
+	*/
+	FThumbnailSyntheticCaptureBackend(int32 NumSlots);
+
+	//IThumbnailCaptureBackend
+	virtual int32 GetNumSlots() const override { return AssetNames.Num(); }
+	virtual bool AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options) override;
+	virtual UPrimitiveComponent* GetActiveComponent(int32 Slot) const override { return nullptr; }
+	virtual void Capture(int32 Slot, const UThumbnailOptions& Options) override;
+
+	/*
+	*	Fill an image with a pattern unique to its name, same name and size always give the same pixels
+	*
+	*	@param	Image		Image with name and size set
+	*/
+	static void FillImage(FThumbnailImage& Image);
+
+private:
+
+	//Name of the asset assigned to every slot
+	TArray<FString> AssetNames;
+};
@@ -0,0 +1,50 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pipeline/ThumbnailCaptureBackend.h"
+
+class FThumbnailCreatorModule;
+
+/*
+*	Captures through the viewport of the ThumbnailCreator tab with a high-res screenshot.
+*	Has a single slot and is only available while the tab is open.
+*/
+class THUMBNAILCREATOR_API FThumbnailViewportCaptureBackend : public IThumbnailCaptureBackend
+{
+public:
+
+	FThumbnailViewportCaptureBackend(FThumbnailCreatorModule& InModule);
+
+	//IThumbnailCaptureBackend
+	virtual int32 GetNumSlots() const override { return 1; }
+	virtual bool IsAvailable() const override;
+	virtual bool AssignAsset(int32 Slot, UObject* Asset, EThumbnailAssetType Type, const UThumbnailOptions& Options) override;
+	virtual UPrimitiveComponent* GetActiveComponent(int32 Slot) const override;
+	virtual void Capture(int32 Slot, const UThumbnailOptions& Options) override;
+
+	//Name of the asset shown in the viewport
+	FString GetAssetName() const;
+
+	/*
+	*	Mark the viewport as painted or not, the viewport widget outlives its tab
+	*
+	*	@param	bInAvailable	Is the tab open?
+	*/
+	void SetAvailable(bool bInAvailable);
+
+	/*
+	*	Called by the viewport client once a requested shot has been read back into memory
+	*
+	*	@param	Image		Captured pixels, empty if the readback failed
+	*/
+	void OnViewportReadback(FThumbnailImage&& Image);
+
+private:
+
+	FThumbnailCreatorModule& Module;
+
+	//Is the tab open?
+	bool bAvailable = true;
+};
@@ -0,0 +1,58 @@
+// Copyright (c) Panda Studios Comm. V.  - All Rights Reserves. Under no circumstance should this could be distributed, used, copied or be published without written approved of Panda Studios Comm. V. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class FThumbnailPipeline;
+class STextBlock;
+class SProgressBar;
+
+/*
+*	Progress of the running batch: depth of every stage, rate, ETA and failures, with a button to cancel.
+*	Only refreshes on an active timer while the pipeline has work, an idle pipeline costs nothing per frame.
+*/
+class SThumbnailProgress : public SCompoundWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SThumbnailProgress) {}
+	SLATE_END_ARGS()
+
+	/*
+	*	Build the panel
+	*
+	*	@param	InArgs		Slate arguments
+	*	@param	InPipeline	Pipeline to show the progress of
+	*/
+	void Construct(const FArguments& InArgs, const TSharedRef<FThumbnailPipeline>& InPipeline);
+	virtual ~SThumbnailProgress();
+
+private:
+
+	//Remember where the batch started and start refreshing
+	void OnBatchStarted();
+
+	//Active timer, stops itself once the pipeline is idle
+	EActiveTimerReturnType UpdateProgress(double InCurrentTime, float InDeltaTime);
+
+	//Read the pipeline counters into the widgets
+	void Refresh();
+
+	FReply OnCancelClicked();
+
+	TWeakPtr<FThumbnailPipeline> Pipeline;
+	FDelegateHandle BatchStartedHandle;
+	TWeakPtr<FActiveTimerHandle> ActiveTimer;
+
+	//Time and finished count when the batch started, the rate only counts this batch
+	double BatchStartTime = 0.0;
+	int32 BatchStartFinished = 0;
+
+	TSharedPtr<STextBlock> StatusText;
+	TSharedPtr<STextBlock> StagesText;
+	TSharedPtr<STextBlock> ResultText;
+	TSharedPtr<SProgressBar> ProgressBar;
+	TSharedPtr<SWidget> CancelButton;
+};
@@ -3,12 +3,22 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Runtime/Core/Public/Containers/Ticker.h"
 #include "Widgets/Images/SImage.h"
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogThumbnailCreator, Log, All);
+
+//"stat ThumbnailCreator" shows where the time of a batch goes
+DECLARE_STATS_GROUP(TEXT("ThumbnailCreator"), STATGROUP_ThumbnailCreator, STATCAT_Advanced);
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Written"), STAT_ThumbnailBytesWritten, STATGROUP_ThumbnailCreator, THUMBNAILCREATOR_API);
+
+//Time a step in the stats group and as an Unreal Insights scope
+#define THUMBNAIL_SCOPE(Stat) SCOPE_CYCLE_COUNTER(Stat); TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
 
 class FToolBarBuilder;
 class FMenuBuilder;
+enum class EThumbnailAssetType : uint8;
 
 class FThumbnailCreatorModule : public IModuleInterface
 {
@@ -25,10 +35,21 @@ public:
 	/*
 	*	Assign asset to the viewport client scene
 	*
-	*	@param	_Dats		FAssetData of the asset to use
+	*	@param	_Data		FAssetData of the asset to use
+	*	@param	bTakeShot	Should we take a shot with this change?
+	*	@return	true if the asset type is supported and was assigned
+	*/
+	bool AssignAsset(FAssetData _Data, bool bTakeShot);
+
+	/*
+	*	Assign an already loaded asset to the viewport client scene
+	*
+	*	@param	Asset		Loaded asset to use
+	*	@param	Type		Type the asset was resolved to
 	*	@param	bTakeShot	Should we take a shot with this change?
+	*	@return	true if the asset was assigned
 	*/
-	void AssignAsset(FAssetData _Data, bool bTakeShot);
+	bool AssignAsset(UObject* Asset, EThumbnailAssetType Type, bool bTakeShot);
 
 	//Generate all screenshots from selection of the content browser
 	FReply GenerateFromSelection();
@@ -39,29 +60,19 @@ public:
 	//update viewport transform by options variables
 	FReply UpdateViewportTransform();
 
-	//Next in queue for the image tick
-	bool NextInQueue(float Delta);
-
-	//Remove from StartupImages 
-	void RemoveFromPreKnown(const FString ToRemove);
-
 	/** Pointer to the Viewport */
 	TSharedPtr<class SThumbnailViewport> ViewportPtr;
 	//Details view of the screenshot settings
 	TSharedPtr<class IDetailsView> DetailsView;
 
-	//Queue of active to take screenshots
-	TArray<FAssetData> Queue;
-	//All created images still to process
-	TArray<FString> CreatedImages;
-	//Images to ignore for process
-	TArray<FString> StartupImages;
+	//Capture -> import pipeline that processes queued assets, only created once the tab opens or work is queued
+	TSharedPtr<class FThumbnailPipeline> Pipeline;
+
+	//Get the pipeline, creating it on first use
+	class FThumbnailPipeline& GetPipeline();
 
 	//Images save dir
 	FString Path = FPaths::ProjectSavedDir() + "Thumbnails/";
-	
-	//Tick delegate for the 0.03s image tick
-	FTickerDelegate ImageTickDelegate;
 
 	//Thumbnail options for the screenshots
 	class UThumbnailOptions* ThumbnailOptions;
@@ -73,6 +84,12 @@ private:
 	
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
+	//Drop the pipeline with the tab unless it still has work
+	void OnPluginTabClosed(TSharedRef<class SDockTab> Tab);
+
+	//Drop the pipeline once work that outlived the tab is done
+	void OnPipelineIdle();
+
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
 };
\ No newline at end of file
@@ -45,12 +45,17 @@ public class ThumbnailCreator : ModuleRules
                 "LevelEditor",
                 "CoreUObject",
                 "Engine",
+                "RenderCore",
+                "RHI",
                 "Slate",
                 "SlateCore",
                 "ImageWrapper",
                 "AssetRegistry",
                 "PropertyEditor",
                 "AdvancedPreviewScene",
+                "DirectoryWatcher",
+                "SourceControl",
+                "Json",
                 "Paper2D"
 
 